@@ -1,5 +1,7 @@
 #pragma once
 
+#include "harness.hpp"
+
 #include <cstddef>
 #include <cstdio>
 #include <utility>
@@ -25,24 +27,10 @@ template <auto data, typename T> void bench_frozen_unordered_map(auto name) {
 
     constexpr auto map = make_frozen_unordered_map<data, T>();
 
-    printf("size:      %lu\n", sizeof(map));
-
     do_frozen_unordered_map<data, T>(T{});
 
-    T k = static_cast<T>(data[0].first);
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
-        k = map.find(k)->second;
-        ankerl::nanobench::doNotOptimizeAway(k);
+    harness::bench_lookup<data, T>(name, sizeof(map), [&](T key) {
+        auto const it = map.find(key);
+        return it == map.end() ? T{} : it->second;
     });
-
-    auto i = std::size_t{};
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
-        "independent", [&] {
-            auto v = map.find(data[i].first)->second;
-            i++;
-            if (i >= data.size()) {
-                i = 0;
-            }
-            ankerl::nanobench::doNotOptimizeAway(v);
-        });
 }
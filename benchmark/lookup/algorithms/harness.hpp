@@ -0,0 +1,214 @@
+#pragma once
+
+#include <lookup/info.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cinttypes>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nanobench.h>
+
+namespace harness {
+// the names of the run, given to each algorithm's benchmark by main
+struct names {
+    char const *dataset;
+    char const *algorithm;
+};
+
+// long enough to defeat the branch predictor, short enough to stay in L1
+constexpr auto stream_size = std::size_t{1} << 12u;
+constexpr auto miss_percentages = std::array{0, 10, 50, 90, 99};
+
+enum struct distribution { uniform, zipf };
+
+constexpr auto to_string(distribution d) -> char const * {
+    return d == distribution::uniform ? "uniform" : "zipf";
+}
+
+// a stream of lookup keys: hits are drawn from the dataset either uniformly
+// or with Zipf-distributed popularity (s = 1), and misses are drawn uniformly
+// from the keys that are not in the dataset
+template <auto data, typename T>
+auto make_stream(distribution d, int miss_percent) -> std::vector<T> {
+    auto rng = std::mt19937_64{static_cast<std::uint64_t>(miss_percent) * 2u +
+                               static_cast<std::uint64_t>(d)};
+
+    auto keys = std::vector<T>{};
+    for (auto const &p : data) {
+        keys.push_back(static_cast<T>(p.first));
+    }
+    auto sorted_keys = keys;
+    std::sort(sorted_keys.begin(), sorted_keys.end());
+
+    // popularity rank is independent of the key's position in the dataset
+    std::shuffle(keys.begin(), keys.end(), rng);
+    auto weights = std::vector<double>(keys.size(), 1.0);
+    if (d == distribution::zipf) {
+        for (auto i = std::size_t{}; i < weights.size(); ++i) {
+            weights[i] = 1.0 / static_cast<double>(i + 1);
+        }
+    }
+
+    auto pick = std::discrete_distribution<std::size_t>{weights.begin(),
+                                                        weights.end()};
+    auto miss = std::bernoulli_distribution{miss_percent / 100.0};
+    auto any = std::uniform_int_distribution<std::uint64_t>{
+        0, std::numeric_limits<T>::max()};
+
+    auto stream = std::vector<T>(stream_size);
+    for (auto &k : stream) {
+        if (miss(rng)) {
+            do {
+                k = static_cast<T>(any(rng));
+            } while (std::binary_search(sorted_keys.begin(), sorted_keys.end(),
+                                        k));
+        } else {
+            k = keys[pick(rng)];
+        }
+    }
+    return stream;
+}
+
+// a table with a prefilter in front of it reports the filter's size, and the
+// fraction of each stream's misses that get past it
+struct no_prefilter {};
+
+template <typename F> struct prefilter {
+    std::size_t bytes;
+    F may_contain;
+};
+template <typename F> prefilter(std::size_t, F) -> prefilter<F>;
+
+// the size of a table; tables from the lookup library also report the
+// strategy that built them and how their keys are probed
+struct layout {
+    std::size_t bytes{};
+    std::string fields{};
+
+    layout(std::size_t b) : bytes{b} {}
+
+    layout(lookup::table_info const &t) : bytes{t.bytes} {
+        auto const name = t.strategy();
+        char buffer[192];
+        snprintf(buffer, sizeof(buffer),
+                 ", \"strategy\": \"%.*s\", \"mask\": \"0x%" PRIx64
+                 "\", \"max_probes\": %zu, \"average_probes\": %.3f",
+                 static_cast<int>(name.size()), name.data(), t.mask,
+                 t.max_probes, t.average_probes);
+        fields = buffer;
+    }
+};
+
+// one JSON object per line, for tools/benchmark/parse_bench_data.py
+inline auto print_record(names n, layout const &l, char const *stream,
+                         int miss_percent, double ns_per_lookup,
+                         std::string const &extra = {}) -> void {
+    printf("{\"dataset\": \"%s\", \"algorithm\": \"%s\", "
+           "\"bytes\": %zu%s, \"stream\": \"%s\", \"miss_percent\": %d, "
+           "\"ns_per_lookup\": %.4f%s}\n",
+           n.dataset, n.algorithm, l.bytes, l.fields.c_str(), stream,
+           miss_percent, ns_per_lookup, extra.c_str());
+}
+
+template <auto data, typename T>
+auto prefilter_fields(no_prefilter, std::vector<T> const &) -> std::string {
+    return {};
+}
+
+template <auto data, typename T, typename F>
+auto prefilter_fields(prefilter<F> const &f, std::vector<T> const &stream)
+    -> std::string {
+    auto sorted_keys = std::vector<T>{};
+    for (auto const &p : data) {
+        sorted_keys.push_back(static_cast<T>(p.first));
+    }
+    std::sort(sorted_keys.begin(), sorted_keys.end());
+
+    auto misses = std::size_t{};
+    auto false_positives = std::size_t{};
+    for (auto key : stream) {
+        if (not std::binary_search(sorted_keys.begin(), sorted_keys.end(),
+                                   key)) {
+            ++misses;
+            false_positives += f.may_contain(key) ? 1u : 0u;
+        }
+    }
+    auto const percent =
+        misses == 0 ? 0.0
+                    : 100.0 * static_cast<double>(false_positives) /
+                          static_cast<double>(misses);
+
+    char fields[96];
+    snprintf(fields, sizeof(fields),
+             ", \"prefilter_bytes\": %zu, \"false_positive_percent\": %.2f",
+             f.bytes, percent);
+    return fields;
+}
+
+inline auto median_ns(ankerl::nanobench::Bench const &bench, std::size_t batch)
+    -> double {
+    auto const seconds = bench.results().back().median(
+        ankerl::nanobench::Result::Measure::elapsed);
+    return seconds * 1e9 / static_cast<double>(batch);
+}
+
+// lookup must return the default value for a key that is not in the table
+template <auto data, typename T>
+void bench_lookup(names n, layout const &l, auto lookup, auto filter) {
+    printf("size:      %zu\n", l.bytes);
+
+    // each lookup depends on the previous one, so this measures latency
+    T k = static_cast<T>(data[0].first);
+    auto chained = ankerl::nanobench::Bench{};
+    chained.minEpochIterations(2000000).run("chained", [&] {
+        k = lookup(k);
+        ankerl::nanobench::doNotOptimizeAway(k);
+    });
+    print_record(n, l, "chained", 0, median_ns(chained, 1));
+
+    auto i = std::size_t{};
+    auto independent = ankerl::nanobench::Bench{};
+    independent.minEpochIterations(2000000).run("independent", [&] {
+        auto v = lookup(static_cast<T>(data[i].first));
+        i++;
+        if (i >= data.size()) {
+            i = 0;
+        }
+        ankerl::nanobench::doNotOptimizeAway(v);
+    });
+    print_record(n, l, "independent", 0, median_ns(independent, 1));
+
+    for (auto d : {distribution::uniform, distribution::zipf}) {
+        for (auto miss_percent : miss_percentages) {
+            auto const stream = make_stream<data, T>(d, miss_percent);
+            auto const name = std::string{to_string(d)} + " " +
+                              std::to_string(miss_percent) + "% misses";
+
+            auto bench = ankerl::nanobench::Bench{};
+            bench.minEpochIterations(2000000 / stream_size)
+                .batch(stream_size)
+                .unit("lookup")
+                .run(name, [&] {
+                    for (auto key : stream) {
+                        ankerl::nanobench::doNotOptimizeAway(lookup(key));
+                    }
+                });
+            print_record(n, l, to_string(d), miss_percent,
+                         median_ns(bench, stream_size),
+                         prefilter_fields<data>(filter, stream));
+        }
+    }
+}
+
+template <auto data, typename T>
+void bench_lookup(names n, layout const &l, auto lookup) {
+    bench_lookup<data, T>(n, l, lookup, no_prefilter{});
+}
+} // namespace harness
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "harness.hpp"
+#include "pseudo_pext.hpp"
+
+#include <lookup/hw_pext_lookup.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+constexpr auto make_hw_pext() {
+    return lookup::hw_pext_lookup<indirect, max_search_len>::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+__attribute__((noinline, flatten)) T do_hw_pext(T k) {
+    constexpr static auto map =
+        make_hw_pext<data, T, indirect, max_search_len>();
+    return map[k];
+}
+
+template <auto data, typename T, bool indirect = true,
+          std::size_t max_search_len = 2>
+void bench_hw_pext(auto name) {
+    constexpr static auto map =
+        make_hw_pext<data, T, indirect, max_search_len>();
+
+    printf("hw pext:   %d\n", lookup::detail::has_hw_pext() ? 1 : 0);
+
+    do_hw_pext<data, T, indirect, max_search_len>(
+        static_cast<T>(data[0].first));
+    harness::bench_lookup<data, T>(
+        name, lookup::info(map), [&](T key) { return map[key]; });
+}
+
+template <auto data, typename T> void bench_hw_pext_direct(auto name) {
+    bench_hw_pext<data, T, false, 1>(name);
+}
+
+template <auto data, typename T> void bench_hw_pext_indirect_1(auto name) {
+    bench_hw_pext<data, T, true, 1>(name);
+}
+
+template <auto data, typename T> void bench_hw_pext_indirect_2(auto name) {
+    bench_hw_pext<data, T, true, 2>(name);
+}
+
+template <auto data, typename T> void bench_hw_pext_indirect_3(auto name) {
+    bench_hw_pext<data, T, true, 3>(name);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "harness.hpp"
+#include "pseudo_pext.hpp"
+
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+template <typename Strategy, auto data, typename T>
+constexpr auto make_linear_search() {
+    return Strategy::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <typename Strategy, auto data, typename T>
+__attribute__((noinline, flatten)) T do_linear_search(T k) {
+    constexpr static auto map = make_linear_search<Strategy, data, T>();
+    return map[k];
+}
+
+template <typename Strategy, auto data, typename T>
+void bench_linear_search_with(auto name) {
+    constexpr static auto map = make_linear_search<Strategy, data, T>();
+
+    do_linear_search<Strategy, data, T>(static_cast<T>(data[0].first));
+    harness::bench_lookup<data, T>(
+        name, lookup::info(map), [&](T key) { return map[key]; });
+}
+
+template <auto data, typename T> void bench_linear_search(auto name) {
+    bench_linear_search_with<lookup::linear_search_lookup<64>, data, T>(name);
+}
+
+template <auto data, typename T> void bench_simd_linear_search(auto name) {
+    bench_linear_search_with<lookup::simd_linear_search_lookup<64>, data, T>(
+        name);
+}
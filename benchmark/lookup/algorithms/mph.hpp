@@ -1,5 +1,7 @@
 #pragma once
 
+#include "harness.hpp"
+
 #include <array>
 #include <cstddef>
 #include <mph>
@@ -33,20 +35,6 @@ template <auto data, typename T> void bench_mph(auto name) {
     // printf("\nmph\n");
     do_mph<data, T>(T{});
 
-    T k = static_cast<T>(data[0].first);
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
-        k = *map(k);
-        ankerl::nanobench::doNotOptimizeAway(k);
-    });
-
-    auto i = std::size_t{};
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
-        "independent", [&] {
-            auto v = *map(static_cast<T>(data[i].first));
-            i++;
-            if (i >= data.size()) {
-                i = 0;
-            }
-            ankerl::nanobench::doNotOptimizeAway(v);
-        });
+    harness::bench_lookup<data, T>(
+        name, sizeof(map), [&](T key) { return *map(key); });
 }
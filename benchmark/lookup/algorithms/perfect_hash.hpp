@@ -0,0 +1,32 @@
+#pragma once
+
+#include "harness.hpp"
+#include "pseudo_pext.hpp"
+
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/perfect_hash_lookup.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+#include <nanobench.h>
+
+template <auto data, typename T> constexpr auto make_perfect_hash() {
+    return lookup::perfect_hash_lookup<>::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T>
+__attribute__((noinline, flatten)) T do_perfect_hash(T k) {
+    constexpr static auto map = make_perfect_hash<data, T>();
+    return map[k];
+}
+
+template <auto data, typename T> void bench_perfect_hash(auto name) {
+    constexpr static auto map = make_perfect_hash<data, T>();
+
+    do_perfect_hash<data, T>(static_cast<T>(data[0].first));
+    harness::bench_lookup<data, T>(
+        name, lookup::info(map), [&](T key) { return map[key]; });
+}
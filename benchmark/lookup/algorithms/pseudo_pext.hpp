@@ -1,7 +1,12 @@
 #pragma once
 
+#include "harness.hpp"
+
+#include <lookup/info.hpp>
 #include <lookup/input.hpp>
+#include <lookup/prefilter_lookup.hpp>
 #include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/runtime_lookup.hpp>
 
 #include <array>
 #include <cstddef>
@@ -43,26 +48,10 @@ void bench_pseudo_pext(auto name) {
     constexpr static auto map =
         make_pseudo_pext<data, T, indirect, max_search_len>();
 
-    printf("size:      %lu\n", sizeof(map));
-
-    T k = static_cast<T>(data[0].first);
-
-    do_pseudo_pext<data, T, indirect, max_search_len>(k);
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
-        k = map[k];
-        ankerl::nanobench::doNotOptimizeAway(k);
-    });
-
-    auto i = std::size_t{};
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
-        "independent", [&] {
-            auto v = map[static_cast<T>(data[i].first)];
-            i++;
-            if (i >= data.size()) {
-                i = 0;
-            }
-            ankerl::nanobench::doNotOptimizeAway(v);
-        });
+    do_pseudo_pext<data, T, indirect, max_search_len>(
+        static_cast<T>(data[0].first));
+    harness::bench_lookup<data, T>(
+        name, lookup::info(map), [&](T key) { return map[key]; });
 }
 
 template <auto data, typename T> void bench_pseudo_pext_direct(auto name) {
@@ -92,3 +81,31 @@ template <auto data, typename T> void bench_pseudo_pext_indirect_5(auto name) {
 template <auto data, typename T> void bench_pseudo_pext_indirect_6(auto name) {
     bench_pseudo_pext<data, T, true, 6>(name);
 }
+
+// the same table as pseudo_pext_indirect_2, but built at startup
+template <auto data, typename T> void bench_pseudo_pext_runtime(auto name) {
+    static auto arena = lookup::fixed_arena<(1u << 20u)>{};
+    auto const map = lookup::build_runtime<2>(T{}, pp::input_data<data, T>,
+                                              arena);
+    if (not map) {
+        printf("build_runtime failed\n");
+        return;
+    }
+
+    harness::bench_lookup<data, T>(name, lookup::info(*map),
+                                   [&](T key) { return (*map)[key]; });
+}
+
+// pseudo_pext_indirect_2 behind a Bloom filter
+template <auto data, typename T>
+void bench_pseudo_pext_prefiltered(auto name) {
+    constexpr static auto map =
+        lookup::prefilter_lookup<lookup::pseudo_pext_lookup<true, 2>>::make(
+            CX_VALUE(lookup::input<T, T, data.size()>{
+                0, pp::input_data<data, T>}));
+
+    harness::bench_lookup<data, T>(
+        name, lookup::info(map), [&](T key) { return map[key]; },
+        harness::prefilter{sizeof(map.filter),
+                           [&](T key) { return map.may_contain(key); }});
+}
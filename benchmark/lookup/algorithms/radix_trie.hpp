@@ -0,0 +1,29 @@
+#pragma once
+
+#include "harness.hpp"
+#include "pseudo_pext.hpp"
+
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/radix_trie_lookup.hpp>
+
+#include <nanobench.h>
+
+template <auto data, typename T> constexpr auto make_radix_trie() {
+    return lookup::radix_trie_lookup<>::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T>
+__attribute__((noinline, flatten)) T do_radix_trie(T k) {
+    constexpr static auto map = make_radix_trie<data, T>();
+    return map[k];
+}
+
+template <auto data, typename T> void bench_radix_trie(auto name) {
+    constexpr static auto map = make_radix_trie<data, T>();
+
+    do_radix_trie<data, T>(static_cast<T>(data[0].first));
+    harness::bench_lookup<data, T>(
+        name, lookup::info(map), [&](T key) { return map[key]; });
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "allocator.hpp"
+#include "harness.hpp"
 
 #include <cstddef>
 #include <cstdio>
@@ -19,22 +20,9 @@ template <auto data, typename T> void bench_std_unordered_map(auto name) {
         map[p.first] = p.second;
     }
 
-    printf("size:      %lu\n", sizeof(map) + allocated_size);
-
-    T k = static_cast<T>(data[0].first);
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run("chained", [&] {
-        k = map[k];
-        ankerl::nanobench::doNotOptimizeAway(k);
-    });
-
-    auto i = std::size_t{};
-    ankerl::nanobench::Bench().minEpochIterations(2000000).run(
-        "independent", [&] {
-            auto v = map[static_cast<T>(data[i].first)];
-            i++;
-            if (i >= data.size()) {
-                i = 0;
-            }
-            ankerl::nanobench::doNotOptimizeAway(v);
+    harness::bench_lookup<data, T>(
+        name, sizeof(map) + allocated_size, [&](T key) {
+            auto const it = map.find(key);
+            return it == map.end() ? T{} : it->second;
         });
 }
@@ -0,0 +1,77 @@
+#include "algorithms/pseudo_pext.hpp"
+
+#include <lookup/batch.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <string>
+
+#include <nanobench.h>
+
+#define STRINGIFY(S) #S
+#define STR(S) STRINGIFY(S)
+
+namespace {
+constexpr auto max_batch_size = std::size_t{4096};
+
+template <auto data, typename T, typename Strategy> constexpr auto make_map() {
+    return Strategy::make(
+        CX_VALUE(lookup::input<T, T, data.size()>{0, pp::input_data<data, T>}));
+}
+
+template <auto data, typename T, typename Strategy>
+void bench_batch(std::string const &name) {
+    constexpr static auto map = make_map<data, T, Strategy>();
+
+    auto keys = std::array<T, max_batch_size>{};
+    auto values = std::array<T, max_batch_size>{};
+    for (auto i = std::size_t{}; i < keys.size(); ++i) {
+        keys[i] = static_cast<T>(data[(i * 7) % data.size()].first);
+    }
+
+    for (auto n = std::size_t{8}; n <= max_batch_size; n *= 2) {
+        auto const k = std::span<T const>{keys}.first(n);
+        auto const v = std::span<T>{values}.first(n);
+
+        ankerl::nanobench::Bench()
+            .minEpochIterations(2000000 / n)
+            .batch(n)
+            .unit("key")
+            .run(name + " scalar " + std::to_string(n), [&] {
+                for (auto i = std::size_t{}; i < n; ++i) {
+                    v[i] = map[k[i]];
+                }
+                ankerl::nanobench::doNotOptimizeAway(v[0]);
+            });
+
+        ankerl::nanobench::Bench()
+            .minEpochIterations(2000000 / n)
+            .batch(n)
+            .unit("key")
+            .run(name + " batch " + std::to_string(n), [&] {
+                lookup::batch(map, k, v);
+                ankerl::nanobench::doNotOptimizeAway(v[0]);
+            });
+    }
+}
+} // namespace
+
+int main() {
+    printf("\n\n\ndataset:   %s\n", STR(DATASET));
+    using T = decltype(DATASET[0].first);
+
+    if constexpr (DATASET.size() <= 16) {
+        bench_batch<DATASET, T, lookup::linear_search_lookup<16>>(
+            "linear_search");
+    }
+    bench_batch<DATASET, T, lookup::pseudo_pext_lookup<>>("pseudo_pext_direct");
+    bench_batch<DATASET, T, lookup::pseudo_pext_lookup<true, 2>>(
+        "pseudo_pext_indirect_2");
+}
@@ -0,0 +1,30 @@
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+
+// NOTE: this benchmark measures the compile-time cost of building a table, so
+// it is compiled without raising the constexpr evaluation limits. the mask
+// search still counts every key for every candidate bit, so larger tables
+// need raised limits: beyond about a thousand keys with GCC, and sooner with
+// Clang, whose default limit is lower
+namespace {
+using T = decltype(DATASET[0].first);
+
+constexpr auto entries = [] {
+    std::array<lookup::entry<T, T>, DATASET.size()> d{};
+    for (auto i = std::size_t{}; i < d.size(); i++) {
+        d[i] = {DATASET[i].first, DATASET[i].second};
+    }
+    return d;
+}();
+} // namespace
+
+int main(int argc, char *[]) {
+    constexpr static auto map = lookup::pseudo_pext_lookup<true, 2>::make(
+        CX_VALUE(lookup::input<T, T, entries.size()>{0, entries}));
+    return static_cast<int>(map[static_cast<T>(argc)]);
+}
@@ -1,4 +1,9 @@
+#include "algorithms/harness.hpp"
+#include "algorithms/hw_pext.hpp"
+#include "algorithms/linear_search.hpp"
+#include "algorithms/perfect_hash.hpp"
 #include "algorithms/pseudo_pext.hpp"
+#include "algorithms/radix_trie.hpp"
 
 #include "algorithms/frozen_map.hpp"
 #include "algorithms/frozen_unordered_map.hpp"
@@ -13,5 +18,6 @@
 int main() {
     printf("\n\n\ndataset:   %s\n", STR(DATASET));
     printf("algorithm: %s\n", STR(ALG_NAME));
-    ALG_NAME<DATASET, decltype(DATASET[0].first)>(STR(DATASET));
+    ALG_NAME<DATASET, decltype(DATASET[0].first)>(
+        harness::names{STR(DATASET), STR(ALG_NAME)});
 }
@@ -0,0 +1,94 @@
+#include <lookup/detail/select.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nanobench.h>
+
+// keys that match about half the time in a random order, so that a branch on
+// the comparison is mispredicted about half the time
+
+namespace {
+constexpr auto stream_size = std::size_t{1} << 12u;
+
+struct wide_value {
+    std::array<std::uint64_t, 2> words;
+};
+
+auto make_keys(std::uint32_t num_distinct) -> std::vector<std::uint32_t> {
+    auto rng = std::mt19937{42};
+    auto dist = std::uniform_int_distribution<std::uint32_t>{
+        0, num_distinct - 1};
+    auto keys = std::vector<std::uint32_t>(stream_size);
+    for (auto &k : keys) {
+        k = dist(rng);
+    }
+    return keys;
+}
+
+template <typename V>
+void bench_select(std::string const &name, auto select_fn) {
+    auto const keys = make_keys(2);
+    auto const v = V{};
+    ankerl::nanobench::Bench()
+        .minEpochIterations(2000000 / stream_size)
+        .batch(stream_size)
+        .unit("select")
+        .run(name, [&] {
+            auto result = V{};
+            for (auto key : keys) {
+                result = select_fn(key, 0u, v, result);
+                ankerl::nanobench::doNotOptimizeAway(result);
+            }
+        });
+}
+
+void bench_linear_search() {
+    constexpr static auto map = lookup::linear_search_lookup<8>::make(
+        CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 4>{
+            0u, std::array{lookup::entry{0u, 10u}, lookup::entry{2u, 12u},
+                           lookup::entry{4u, 14u},
+                           lookup::entry{6u, 16u}}}));
+
+    auto const keys = make_keys(8);
+    ankerl::nanobench::Bench()
+        .minEpochIterations(2000000 / stream_size)
+        .batch(stream_size)
+        .unit("lookup")
+        .run("linear_search 4 entries, 50% misses", [&] {
+            for (auto key : keys) {
+                ankerl::nanobench::doNotOptimizeAway(map[key]);
+            }
+        });
+}
+} // namespace
+
+int main() {
+    using lookup::detail::fallback_select;
+    using lookup::detail::select;
+    using lookup::detail::select_lt;
+
+    auto const fallback = [](auto... args) { return fallback_select(args...); };
+    auto const branchless = [](auto... args) { return select(args...); };
+    auto const branchless_lt = [](auto... args) {
+        return select_lt(args...);
+    };
+
+    bench_select<std::uint32_t>("fallback_select u32", fallback);
+    bench_select<std::uint32_t>("select u32", branchless);
+    bench_select<std::uint64_t>("fallback_select u64", fallback);
+    bench_select<std::uint64_t>("select u64", branchless);
+    bench_select<std::uint64_t>("select_lt u64", branchless_lt);
+    bench_select<wide_value>("fallback_select 16 bytes", fallback);
+    bench_select<wide_value>("select 16 bytes", branchless);
+
+    bench_linear_search();
+}
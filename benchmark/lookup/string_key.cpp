@@ -0,0 +1,100 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/string_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nanobench.h>
+
+// command names resolved by a string_lookup, a chain of strcmps and a
+// std::map<std::string>, with half of the lookups missing
+
+namespace {
+using namespace std::string_view_literals;
+
+constexpr auto stream_size = std::size_t{1} << 12u;
+
+constexpr auto commands = std::array{
+    lookup::entry{"help"sv, 1},       lookup::entry{"halt"sv, 2},
+    lookup::entry{"reset"sv, 3},      lookup::entry{"read"sv, 4},
+    lookup::entry{"write"sv, 5},      lookup::entry{"writeback"sv, 6},
+    lookup::entry{"erase"sv, 7},      lookup::entry{"status"sv, 8},
+    lookup::entry{"version"sv, 9},    lookup::entry{"reboot"sv, 10},
+    lookup::entry{"log_level"sv, 11}, lookup::entry{"log_sink"sv, 12},
+    lookup::entry{"net_ip"sv, 13},    lookup::entry{"net_mask"sv, 14},
+    lookup::entry{"net_gw"sv, 15},    lookup::entry{"net_dns"sv, 16},
+    lookup::entry{"dev_name"sv, 17},  lookup::entry{"dev_id"sv, 18},
+    lookup::entry{"fan_speed"sv, 19}, lookup::entry{"temp"sv, 20},
+    lookup::entry{"volt"sv, 21},      lookup::entry{"current"sv, 22},
+    lookup::entry{"power"sv, 23},     lookup::entry{"uptime"sv, 24},
+};
+
+constexpr auto misses =
+    std::array{"hello"sv, "rest"sv, "writ"sv,       "net_ipv6"sv,
+               "dev"sv,   "x"sv,    "log_levels"sv, "powerr"sv};
+
+auto make_stream() -> std::vector<std::string> {
+    auto rng = std::mt19937{1};
+    auto stream = std::vector<std::string>(stream_size);
+    for (auto &s : stream) {
+        if (rng() % 2 == 0) {
+            s = commands[rng() % commands.size()].key_;
+        } else {
+            s = misses[rng() % misses.size()];
+        }
+    }
+    return stream;
+}
+
+auto strcmp_chain(char const *s) -> int {
+    for (auto const &[k, v] : commands) {
+        if (std::strcmp(s, k.data()) == 0) {
+            return v;
+        }
+    }
+    return 0;
+}
+
+void bench(char const *name, std::vector<std::string> const &stream,
+           auto lookup) {
+    ankerl::nanobench::Bench()
+        .minEpochIterations(2000000 / stream_size)
+        .batch(stream_size)
+        .unit("lookup")
+        .run(name, [&] {
+            for (auto const &s : stream) {
+                ankerl::nanobench::doNotOptimizeAway(lookup(s));
+            }
+        });
+}
+} // namespace
+
+int main() {
+    constexpr static auto table =
+        lookup::make(CX_VALUE(lookup::input{0, commands}));
+
+    auto map = std::map<std::string, int>{};
+    for (auto const &[k, v] : commands) {
+        map.emplace(k, v);
+    }
+
+    auto const stream = make_stream();
+    bench("string_lookup", stream,
+          [&](std::string const &s) { return table[s]; });
+    bench("strcmp chain", stream,
+          [&](std::string const &s) { return strcmp_chain(s.c_str()); });
+    bench("std::map<std::string>", stream, [&](std::string const &s) {
+        auto const it = map.find(s);
+        return it == map.end() ? 0 : it->second;
+    });
+}
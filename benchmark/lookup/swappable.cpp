@@ -0,0 +1,88 @@
+#include <lookup/arena.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/runtime_lookup.hpp>
+#include <lookup/swappable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <nanobench.h>
+
+// reader throughput on a swappable runtime table, first with the table left
+// alone and then while another thread rebuilds and publishes it continuously
+
+namespace {
+constexpr auto num_keys = std::size_t{256};
+constexpr auto stream_size = std::size_t{1} << 12u;
+
+using table_t = lookup::runtime_lookup<std::uint32_t, std::uint32_t, 2>;
+using arena_t = lookup::fixed_arena<32768>;
+
+auto make_entries(std::uint32_t generation) {
+    auto entries =
+        std::array<lookup::entry<std::uint32_t, std::uint32_t>, num_keys>{};
+    auto rng = std::mt19937{1};
+    for (auto i = std::size_t{}; i < num_keys; ++i) {
+        entries[i] = {static_cast<std::uint32_t>(rng()),
+                      generation + static_cast<std::uint32_t>(i)};
+    }
+    return entries;
+}
+
+auto build(arena_t &arena, std::uint32_t generation) -> table_t {
+    auto const entries = make_entries(generation);
+    arena.rewind(0);
+    return *lookup::build_runtime(0u, entries, arena);
+}
+
+auto make_stream() -> std::vector<std::uint32_t> {
+    auto const entries = make_entries(0);
+    auto rng = std::mt19937{2};
+    auto stream = std::vector<std::uint32_t>(stream_size);
+    for (auto &k : stream) {
+        k = rng() % 2 == 0 ? entries[rng() % num_keys].key_
+                           : static_cast<std::uint32_t>(rng());
+    }
+    return stream;
+}
+
+void bench(char const *name, lookup::swappable<table_t> &s,
+           std::vector<std::uint32_t> const &stream) {
+    auto r = s.register_reader();
+    ankerl::nanobench::Bench()
+        .minEpochIterations(2000000 / stream_size)
+        .batch(stream_size)
+        .unit("lookup")
+        .run(name, [&] {
+            for (auto key : stream) {
+                ankerl::nanobench::doNotOptimizeAway(s[key]);
+            }
+            r->quiescent();
+        });
+}
+} // namespace
+
+int main() {
+    auto arenas = std::array<arena_t, 2>{};
+    auto s = lookup::swappable<table_t>{build(arenas[0], 0)};
+    auto const stream = make_stream();
+
+    bench("no swaps", s, stream);
+
+    auto done = std::atomic<bool>{};
+    auto writer = std::thread{[&] {
+        for (auto g = std::uint32_t{1}; not done; ++g) {
+            s.publish(build(arenas[g % 2], g));
+        }
+    }};
+    bench("continuous swaps", s, stream);
+    done = true;
+    writer.join();
+    printf("%llu swaps\n", static_cast<unsigned long long>(s.version()));
+}
@@ -0,0 +1,108 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/multiword_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nanobench.h>
+
+// 128-bit keys (random, like GUIDs) looked up in a multiword_pext_lookup and
+// in a std::unordered_map, with half of the lookups missing
+
+namespace {
+constexpr auto stream_size = std::size_t{1} << 12u;
+
+using u128 = lookup::detail::uint128_t;
+
+constexpr auto splitmix64(std::uint64_t &state) -> std::uint64_t {
+    auto z = (state += 0x9e37'79b9'7f4a'7c15u);
+    z = (z ^ (z >> 30u)) * 0xbf58'476d'1ce4'e5b9u;
+    z = (z ^ (z >> 27u)) * 0x94d0'49bb'1331'11ebu;
+    return z ^ (z >> 31u);
+}
+
+template <std::size_t N> constexpr auto make_entries() {
+    auto entries = std::array<lookup::entry<u128, std::uint32_t>, N>{};
+    auto state = std::uint64_t{N};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        auto const hi = splitmix64(state);
+        auto const lo = splitmix64(state);
+        entries[i] = {(static_cast<u128>(hi) << 64u) | lo,
+                      static_cast<std::uint32_t>(i + 1)};
+    }
+    return entries;
+}
+
+struct u128_hash {
+    auto operator()(u128 k) const -> std::size_t {
+        return std::hash<std::uint64_t>{}(static_cast<std::uint64_t>(k) ^
+                                          static_cast<std::uint64_t>(k >> 64u) *
+                                              0x9e37'79b9'7f4a'7c15u);
+    }
+};
+
+template <std::size_t N> auto make_stream() -> std::vector<u128> {
+    constexpr auto entries = make_entries<N>();
+    auto rng = std::mt19937_64{N};
+    auto pick = std::uniform_int_distribution<std::size_t>{0, N - 1};
+    auto stream = std::vector<u128>(stream_size);
+    for (auto &k : stream) {
+        k = entries[pick(rng)].key_;
+        if (rng() % 2 == 0) {
+            k ^= static_cast<u128>(rng() | 1u) << 64u;
+        }
+    }
+    return stream;
+}
+
+void bench(std::string const &name, std::vector<u128> const &stream,
+           auto lookup) {
+    ankerl::nanobench::Bench()
+        .minEpochIterations(2000000 / stream_size)
+        .batch(stream_size)
+        .unit("lookup")
+        .run(name, [&] {
+            for (auto key : stream) {
+                ankerl::nanobench::doNotOptimizeAway(lookup(key));
+            }
+        });
+}
+
+template <std::size_t N> void bench_size() {
+    constexpr static auto entries = make_entries<N>();
+    constexpr static auto table =
+        lookup::multiword_pext_lookup<lookup::default_strategy>::make(
+            CX_VALUE(lookup::input<u128, std::uint32_t, N>{0, entries}));
+    printf("%zu keys: %zu bits extracted, %zu bytes\n", N,
+           table.extract.bits, sizeof(table));
+
+    auto map = std::unordered_map<u128, std::uint32_t, u128_hash>{};
+    for (auto const &e : entries) {
+        map.emplace(e.key_, e.value_);
+    }
+
+    auto const stream = make_stream<N>();
+    auto const n = std::to_string(N);
+    bench("multiword_pext " + n, stream, [&](u128 k) { return table[k]; });
+    bench("std::unordered_map " + n, stream, [&](u128 k) {
+        auto const it = map.find(k);
+        return it == map.end() ? std::uint32_t{} : it->second;
+    });
+}
+} // namespace
+
+int main() {
+    bench_size<16>();
+    bench_size<100>();
+    bench_size<1000>();
+}
@@ -3,6 +3,7 @@
 #include <cib/cib.hpp>
 #include <match/ops.hpp>
 #include <msg/callback.hpp>
+#include <msg/decision_tree_service.hpp>
 #include <msg/field.hpp>
 #include <msg/indexed_service.hpp>
 #include <msg/message.hpp>
@@ -11,6 +12,9 @@
 #include <stdx/utility.hpp>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 #include <nanobench.h>
 
@@ -34,6 +38,7 @@ using msg_t = owning<msg_defn>;
 struct test_indexed_service
     : indexed_service<index_spec<big_f, med_f, small_a_f>, msg_t> {};
 struct test_service : service<msg_t> {};
+struct test_decision_tree_service : decision_tree_service<msg_t> {};
 
 uint64_t cb_count{};
 uint64_t volatile *cb_count_ptr = &cb_count;
@@ -238,9 +243,34 @@ template <typename T> void bench_handler() {
         cib::service<T>->handle(msgs[i]);
         i = (i + 1) % msgs.size();
     });
+
+    // the same messages arriving in bursts, timed per message
+    constexpr auto burst = std::size_t{32};
+    auto const bursts = std::span<msg_t const>{msgs};
+    i = 0;
+    ankerl::nanobench::Bench()
+        .minEpochIterations(100000)
+        .batch(burst)
+        .run("msgs in bursts of 32", [&] {
+            cib::service<T>->handle_batch(bursts.subspan(i, burst));
+            i = (i + burst) % (msgs.size() - burst);
+        });
+
+    // messages that no callback claims: no callback has a small "big" field
+    auto misses = std::array<msg_t, 64>{};
+    for (auto j = std::size_t{}; j < misses.size(); ++j) {
+        misses[j] = msg_t{"big"_field = static_cast<std::uint32_t>(j),
+                          "med"_field = 1721u, "small_a"_field = 4u};
+    }
+    i = 0;
+    ankerl::nanobench::Bench().minEpochIterations(2000000).run("misses", [&] {
+        cib::service<T>->handle(misses[i]);
+        i = (i + 1) % misses.size();
+    });
 }
 
 int main() {
     bench_handler<test_indexed_service>();
+    bench_handler<test_decision_tree_service>();
     bench_handler<test_service>();
 }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace lookup {
+/// an arena hands out memory that lives as long as it does; it never frees
+/// individual allocations. allocate returns nullptr when it is exhausted
+template <typename T>
+concept arena = requires(T &t, std::size_t size, std::size_t align) {
+    { t.allocate(size, align) } -> std::same_as<void *>;
+};
+
+/// an arena that can give back everything allocated since a mark
+template <typename T>
+concept rewindable_arena = arena<T> and requires(T &t) {
+    { t.mark() } -> std::same_as<std::size_t>;
+    t.rewind(t.mark());
+};
+
+/// a bump allocator over a fixed buffer, e.g. a static or on the stack
+template <std::size_t Bytes> struct fixed_arena {
+    [[nodiscard]] auto allocate(std::size_t size, std::size_t align)
+        -> void * {
+        auto const start = (used + align - 1) & ~(align - 1);
+        if (start > Bytes or size > Bytes - start) {
+            return nullptr;
+        }
+        used = start + size;
+        return buffer.data() + start;
+    }
+
+    [[nodiscard]] auto mark() const -> std::size_t { return used; }
+    auto rewind(std::size_t m) -> void { used = m; }
+
+    [[nodiscard]] constexpr static auto capacity() -> std::size_t {
+        return Bytes;
+    }
+    [[nodiscard]] auto size() const -> std::size_t { return used; }
+
+  private:
+    alignas(std::max_align_t) std::array<std::byte, Bytes> buffer{};
+    std::size_t used{};
+};
+
+namespace detail {
+/// n value-initialized Ts from the arena, or an empty span if it is exhausted
+/// (or if n Ts would not fit in memory at all)
+template <typename T>
+auto allocate_array(arena auto &a, std::size_t n) -> std::span<T> {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena allocations are never destroyed.");
+    if (n == 0 or n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        return {};
+    }
+    auto *const p = a.allocate(n * sizeof(T), alignof(T));
+    if (p == nullptr) {
+        return {};
+    }
+    auto *const first = static_cast<T *>(p);
+    std::uninitialized_value_construct_n(first, n);
+    return {first, n};
+}
+} // namespace detail
+} // namespace lookup
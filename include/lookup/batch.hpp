@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace lookup {
+template <typename T>
+concept batch_lookup =
+    requires(T const &t, std::span<typename T::key_type const> keys,
+             std::span<typename T::value_type> values) {
+        t.batch(keys, values);
+    };
+
+// look up every key in keys, writing each result to the corresponding
+// position in values (which must be at least as long as keys)
+template <typename Table>
+constexpr auto batch(Table const &table,
+                     std::span<typename Table::key_type const> keys,
+                     std::span<typename Table::value_type> values) -> void {
+    if constexpr (batch_lookup<Table>) {
+        table.batch(keys, values);
+    } else {
+        for (auto i = std::size_t{}; i < keys.size(); ++i) {
+            values[i] = table[keys[i]];
+        }
+    }
+}
+} // namespace lookup
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lookup {
+/// the compile-time cost of a lookup table: storage size, worst-case number of
+/// probes into table storage, and an estimate of the instructions executed by
+/// a worst-case lookup
+struct cost_t {
+    std::size_t bytes{};
+    std::size_t probes{};
+    std::size_t instructions{};
+
+    friend constexpr auto operator==(cost_t const &, cost_t const &)
+        -> bool = default;
+};
+
+template <typename T>
+concept costed = requires(T const &t) {
+    { t.cost() } -> std::same_as<cost_t>;
+};
+
+/// tables that do not report a cost are assumed to probe once
+template <typename T> [[nodiscard]] constexpr auto cost(T const &t) -> cost_t {
+    if constexpr (costed<T>) {
+        return t.cost();
+    } else {
+        return {sizeof(T), 1, 1};
+    }
+}
+
+/// a policy scores a cost; strategies picks the lowest score, and the first
+/// of equally-scored strategies
+template <typename T>
+concept selection_policy = requires(cost_t const &c) {
+    { T::score(c) } -> std::same_as<std::uint64_t>;
+};
+
+struct first_success {
+    [[nodiscard]] constexpr static auto score(cost_t const &)
+        -> std::uint64_t {
+        return 0;
+    }
+};
+
+template <std::size_t BytesWeight, std::size_t ProbesWeight,
+          std::size_t InstructionsWeight>
+struct weighted {
+    [[nodiscard]] constexpr static auto score(cost_t const &c)
+        -> std::uint64_t {
+        return std::uint64_t{BytesWeight} * c.bytes +
+               std::uint64_t{ProbesWeight} * c.probes +
+               std::uint64_t{InstructionsWeight} * c.instructions;
+    }
+};
+
+// NOTE: for speed, a probe into table storage is weighted as a few
+// instructions (an L1 hit); size breaks ties
+struct optimize_for_speed {
+    [[nodiscard]] constexpr static auto score(cost_t const &c)
+        -> std::uint64_t {
+        constexpr auto bytes_range = std::uint64_t{1} << 32u;
+        auto const time = std::uint64_t{4} * c.probes + c.instructions;
+        return time * bytes_range +
+               std::min(std::uint64_t{c.bytes}, bytes_range - 1u);
+    }
+};
+
+struct optimize_for_size {
+    [[nodiscard]] constexpr static auto score(cost_t const &c)
+        -> std::uint64_t {
+        constexpr auto time_range = std::uint64_t{1} << 16u;
+        auto const time = std::uint64_t{4} * c.probes + c.instructions;
+        return std::uint64_t{c.bytes} * time_range +
+               std::min(time, time_range - 1u);
+    }
+};
+
+/// the policy used by strategies that are not given one; a build may
+/// override it with a specialization:
+///   template <> inline auto lookup::strategy_policy<> =
+///       lookup::optimize_for_size{};
+template <typename...> inline auto strategy_policy = first_success{};
+
+namespace detail {
+template <typename T, typename... DummyArgs>
+consteval auto default_policy() {
+    return std::type_identity<
+        std::remove_cvref_t<decltype(strategy_policy<DummyArgs...>)>>{};
+}
+} // namespace detail
+} // namespace lookup
@@ -0,0 +1,95 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lookup {
+template <std::size_t MaxSpanRatio = 2> struct dense_array_lookup {
+  private:
+    template <typename Key, typename Value, std::size_t Span> struct impl {
+        using key_type = Key;
+        using value_type = Value;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+
+        raw_key_type min_key;
+        value_type default_value;
+        std::array<value_type, Span> storage;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            // keys below min_key wrap around and fail the same bounds check
+            auto const offset = static_cast<raw_key_type>(
+                detail::as_ordered_integral(key) - min_key);
+            if (offset < Span) {
+                return storage[offset];
+            }
+            return default_value;
+        }
+
+        // offset, bounds check, load and select
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), 1, 4};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {"dense_array", sizeof(*this), 0, 1, 1};
+        }
+    };
+
+    template <typename Input>
+    constexpr static auto key_range(Input const &input) {
+        auto const [min, max] = std::minmax_element(
+            input.entries.begin(), input.entries.end(),
+            [](auto const &lhs, auto const &rhs) {
+                return detail::as_ordered_integral(lhs.key_) <
+                       detail::as_ordered_integral(rhs.key_);
+            });
+        return std::array{detail::as_ordered_integral(min->key_),
+                          detail::as_ordered_integral(max->key_)};
+    }
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using input_t = std::remove_cv_t<decltype(input)>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+
+        if constexpr (input.size == 0) {
+            return strategy_failed_t{};
+        } else {
+            constexpr auto range = key_range(input);
+            constexpr auto max_offset =
+                static_cast<std::uint64_t>(range[1] - range[0]);
+
+            if constexpr (max_offset >= MaxSpanRatio * input.size) {
+                return strategy_failed_t{};
+            } else {
+                static_assert(
+                    detail::keys_are_unique(detail::get_keys(input.entries)),
+                    "Lookup keys must be unique.");
+
+                constexpr auto span = static_cast<std::size_t>(max_offset + 1);
+                using impl_t = impl<key_type, value_type, span>;
+                auto storage = std::array<value_type, span>{};
+                storage.fill(input.default_value);
+                for (auto const &e : input.entries) {
+                    storage[static_cast<std::size_t>(
+                        detail::as_ordered_integral(e.key_) - range[0])] =
+                        e.value_;
+                }
+                return impl_t{range[0], input.default_value, storage};
+            }
+        }
+    }
+};
+} // namespace lookup
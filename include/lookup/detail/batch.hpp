@@ -0,0 +1,74 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace lookup::detail {
+// number of probe keys that a batched lookup compares against each table
+// entry at once; the loop over the lanes is left for the compiler to vectorize
+constexpr inline auto batch_lanes = std::size_t{16};
+
+template <typename P>
+concept multiply_shift_pext_u32 =
+    std::same_as<std::remove_cvref_t<decltype(P::coefficient)>,
+                 std::uint32_t>;
+
+// returns the number of keys that were handled by a vector kernel; the caller
+// handles the remainder
+template <typename PextFunc, typename Storage, typename K, typename V>
+inline auto vector_direct_batch(PextFunc const &, Storage const &,
+                                std::span<K const>, std::span<V>, V const &)
+    -> std::size_t {
+    return 0;
+}
+
+#if defined(__AVX2__)
+// the probe keys are loaded as they are in memory, so only keys that are
+// stored that way qualify: composite keys are stored packed
+template <multiply_shift_pext_u32 PextFunc, typename Storage, typename K,
+          typename V>
+    requires((std::integral<K> or std::is_enum_v<K>) and sizeof(K) == 4 and
+             sizeof(V) == 4 and
+             sizeof(typename Storage::value_type) == 8 and
+             std::is_trivially_copyable_v<V>)
+inline auto vector_direct_batch(PextFunc const &p, Storage const &storage,
+                                std::span<K const> keys, std::span<V> values,
+                                V const &default_value) -> std::size_t {
+    auto const mask = _mm256_set1_epi32(static_cast<int>(p.mask));
+    auto const coefficient =
+        _mm256_set1_epi32(static_cast<int>(p.coefficient));
+    auto const final_mask = _mm256_set1_epi32(static_cast<int>(p.final_mask));
+    auto const gap_bits = _mm_cvtsi32_si128(static_cast<int>(p.gap_bits));
+    auto const def = _mm256_set1_epi32(std::bit_cast<int>(default_value));
+
+    // each storage entry is a {key, value} pair of 32-bit words
+    auto const *base = reinterpret_cast<int const *>(storage.data());
+
+    auto i = std::size_t{};
+    for (; i + 8 <= keys.size(); i += 8) {
+        auto const k = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(keys.data() + i));
+        auto const packed =
+            _mm256_mullo_epi32(_mm256_and_si256(k, mask), coefficient);
+        auto const idx =
+            _mm256_and_si256(_mm256_srl_epi32(packed, gap_bits), final_mask);
+
+        auto const stored_keys = _mm256_i32gather_epi32(base, idx, 8);
+        auto const stored_values = _mm256_i32gather_epi32(base + 1, idx, 8);
+        auto const hit = _mm256_cmpeq_epi32(k, stored_keys);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values.data() + i),
+                            _mm256_blendv_epi8(def, stored_values, hit));
+    }
+    return i;
+}
+#endif
+} // namespace lookup::detail
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lookup::detail {
+/// a key made of several fields, e.g. std::tuple or std::pair
+template <typename T>
+concept composite_key = requires { std::tuple_size<T>::value; };
+
+template <typename T> constexpr auto is_signed_key() -> bool {
+    if constexpr (std::is_enum_v<T>) {
+        return std::is_signed_v<std::underlying_type_t<T>>;
+    } else {
+        return std::is_signed_v<T>;
+    }
+}
+
+constexpr auto as_raw_scalar(auto v) {
+    static_assert(sizeof(v) <= 8);
+
+    if constexpr (sizeof(v) == 1) {
+        return std::bit_cast<std::uint8_t>(v);
+
+    } else if constexpr (sizeof(v) == 2) {
+        return std::bit_cast<std::uint16_t>(v);
+
+    } else if constexpr (sizeof(v) <= 4) {
+        return std::bit_cast<std::uint32_t>(v);
+
+    } else if constexpr (sizeof(v) <= 8) {
+        return std::bit_cast<std::uint64_t>(v);
+    }
+}
+
+template <typename T> constexpr auto as_ordered_scalar(T v) {
+    auto const raw = as_raw_scalar(v);
+    using raw_t = decltype(raw);
+    if constexpr (is_signed_key<T>()) {
+        constexpr auto sign_bit = static_cast<raw_t>(
+            raw_t{1} << (std::numeric_limits<raw_t>::digits - 1));
+        return static_cast<raw_t>(raw ^ sign_bit);
+    } else {
+        return raw;
+    }
+}
+
+template <typename T>
+constexpr auto scalar_bits = static_cast<std::size_t>(
+    std::numeric_limits<decltype(as_raw_scalar(std::declval<T>()))>::digits);
+
+template <typename T>
+constexpr auto composite_key_bits =
+    []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (std::size_t{} + ... +
+                scalar_bits<std::tuple_element_t<Is, T>>);
+    }(std::make_index_sequence<std::tuple_size_v<T>>{});
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using int128_t = __int128;
+__extension__ using uint128_t = unsigned __int128;
+
+template <typename T>
+concept int128_key =
+    std::is_same_v<T, int128_t> or std::is_same_v<T, uint128_t>;
+#else
+template <typename T>
+concept int128_key = false;
+#endif
+
+/// keys that fit in a single raw integral
+template <typename T>
+concept packable_key = (composite_key<T> and composite_key_bits<T> <= 64) or
+                       (not composite_key<T> and sizeof(T) <= 8);
+
+template <std::size_t Bits> auto uint_for_bits_f() {
+    if constexpr (Bits <= 8) {
+        return std::uint8_t{};
+    } else if constexpr (Bits <= 16) {
+        return std::uint16_t{};
+    } else if constexpr (Bits <= 32) {
+        return std::uint32_t{};
+    } else {
+        return std::uint64_t{};
+    }
+}
+
+/// the fields of a composite key are packed with the first field in the most
+/// significant bits; each field is packed in its ordered form, so packed keys
+/// compare lexicographically
+template <composite_key T> constexpr auto pack_key(T const &v) {
+    static_assert(composite_key_bits<T> <= 64,
+                  "Composite lookup keys wider than 64 bits need "
+                  "two_level_lookup.");
+    using raw_t = decltype(uint_for_bits_f<composite_key_bits<T>>());
+
+    return std::apply(
+        [](auto const &...fields) {
+            auto raw = raw_t{};
+            auto const append = [&](auto field) {
+                constexpr auto bits = scalar_bits<decltype(field)>;
+                if constexpr (bits < std::numeric_limits<raw_t>::digits) {
+                    raw = static_cast<raw_t>(raw << bits);
+                }
+                raw = static_cast<raw_t>(raw | as_ordered_scalar(field));
+            };
+            (append(fields), ...);
+            return raw;
+        },
+        v);
+}
+
+constexpr auto as_raw_integral(auto v) {
+    if constexpr (composite_key<decltype(v)>) {
+        return pack_key(v);
+    } else {
+        return as_raw_scalar(v);
+    }
+}
+
+template <typename T>
+using raw_integral_t = decltype(as_raw_integral(std::declval<T>()));
+
+/// a raw integral that preserves the ordering of signed keys
+template <typename T> constexpr auto as_ordered_integral(T v) {
+    if constexpr (composite_key<T>) {
+        return pack_key(v);
+    } else {
+        return as_ordered_scalar(v);
+    }
+}
+template <typename T> constexpr auto num_key_words_f() -> std::size_t {
+    if constexpr (composite_key<T>) {
+        // a field never straddles two words
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            auto words = std::size_t{1};
+            auto used = std::size_t{};
+            (
+                [&] {
+                    constexpr auto bits =
+                        scalar_bits<std::tuple_element_t<Is, T>>;
+                    if (used + bits > 64) {
+                        ++words;
+                        used = 0;
+                    }
+                    used += bits;
+                }(),
+                ...);
+            return words;
+        }(std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else {
+        return (sizeof(T) + 7) / 8;
+    }
+}
+
+/// the number of 64-bit words that a key is split into by as_words
+template <typename T>
+constexpr auto num_key_words = num_key_words_f<T>();
+
+template <typename T>
+using key_words_t = std::array<std::uint64_t, num_key_words<T>>;
+
+/// a key of any width as 64-bit words: 128-bit integers are split in two, and
+/// the fields of composite keys are packed into as few words as they fit
+template <typename T> constexpr auto as_words(T const &v) -> key_words_t<T> {
+    auto words = key_words_t<T>{};
+    if constexpr (int128_key<T>) {
+        auto const u = static_cast<uint128_t>(v);
+        words[0] = static_cast<std::uint64_t>(u);
+        words[1] = static_cast<std::uint64_t>(u >> 64u);
+
+    } else if constexpr (composite_key<T>) {
+        auto w = std::size_t{};
+        auto used = std::size_t{};
+        std::apply(
+            [&](auto const &...fields) {
+                auto const append = [&](auto field) {
+                    constexpr auto bits = scalar_bits<decltype(field)>;
+                    if (used + bits > 64) {
+                        ++w;
+                        used = 0;
+                    }
+                    words[w] |= static_cast<std::uint64_t>(
+                                    as_raw_scalar(field))
+                                << used;
+                    used += bits;
+                };
+                (append(fields), ...);
+            },
+            v);
+
+    } else {
+        words[0] = as_raw_scalar(v);
+    }
+    return words;
+}
+} // namespace lookup::detail
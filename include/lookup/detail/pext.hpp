@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace lookup::detail {
+template <typename T>
+constexpr inline auto fallback_pext(T value, T mask) -> T {
+    auto result = T{};
+    for (auto dst = 0; mask != 0; ++dst) {
+        auto const src = std::countr_zero(mask);
+        result |= static_cast<T>(((value >> src) & 1u) << dst);
+        mask &= static_cast<T>(mask - 1u);
+    }
+    return result;
+}
+
+// NOTE: hw_pext uses the BMI2 pext instruction only when the target is
+// compiled with BMI2 enabled. Choosing it at runtime would cost a branch and
+// an out-of-line call on every extraction, more than the multiply it saves.
+#if defined(__BMI2__) and (defined(__GNUC__) or defined(__clang__))
+constexpr inline auto has_hw_pext() -> bool { return true; }
+
+template <typename T> inline auto hw_pext(T value, T mask) -> T {
+    if constexpr (sizeof(T) <= 4) {
+        return static_cast<T>(__builtin_ia32_pext_si(value, mask));
+    } else {
+        return static_cast<T>(__builtin_ia32_pext_di(value, mask));
+    }
+}
+#else
+constexpr inline auto has_hw_pext() -> bool { return false; }
+
+template <typename T> inline auto hw_pext(T value, T mask) -> T {
+    return fallback_pext(value, mask);
+}
+#endif
+
+template <typename T> struct hw_pext_t {
+    // each contiguous stretch of set bits in the mask is extracted with a
+    // shift and a mask when the pext instruction is not available
+    struct stretch_t {
+        int shift;
+        T mask;
+    };
+    constexpr static auto max_stretches =
+        static_cast<std::size_t>(std::numeric_limits<T>::digits / 2);
+
+    T mask;
+    std::size_t num_stretches{};
+    std::array<stretch_t, max_stretches> stretches{};
+
+    constexpr explicit hw_pext_t(T mask_arg) : mask{mask_arg} {
+        auto remaining = mask;
+        auto dst = 0;
+        while (remaining != 0) {
+            auto const src = std::countr_zero(remaining);
+            auto const len = std::countr_one(static_cast<T>(remaining >> src));
+            auto const len_mask = len == std::numeric_limits<T>::digits
+                                      ? std::numeric_limits<T>::max()
+                                      : static_cast<T>((T{1} << len) - 1u);
+            stretches[num_stretches++] = {src - dst,
+                                          static_cast<T>(len_mask << dst)};
+            remaining &= static_cast<T>(~static_cast<T>(len_mask << src));
+            dst += len;
+        }
+    }
+
+    [[nodiscard]] constexpr auto soft_pext(T value) const -> T {
+        auto result = T{};
+        for (auto i = std::size_t{}; i < num_stretches; ++i) {
+            auto const [shift, m] = stretches[i];
+            result |= static_cast<T>((value >> shift) & m);
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr static auto name() -> std::string_view {
+        return "hw_pext";
+    }
+
+    /// an estimate of the instructions executed by an extraction
+    [[nodiscard]] constexpr auto instructions() const -> std::size_t {
+#if defined(__BMI2__)
+        return 1;
+#else
+        return 2 + 3 * num_stretches;
+#endif
+    }
+
+    [[nodiscard]] constexpr auto operator()(T value) const -> T {
+        if constexpr (has_hw_pext()) {
+            if (not std::is_constant_evaluated()) {
+                return hw_pext(value, mask);
+            }
+        }
+        return soft_pext(value);
+    }
+};
+} // namespace lookup::detail
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 namespace lookup::detail {
@@ -62,6 +66,139 @@ static inline auto optimized_select_lt(K raw_lhs, K raw_rhs, T first, T second)
 
     return result;
 }
+#elif defined(__x86_64__) or defined(__aarch64__)
+template <typename K>
+concept select_key = (std::is_integral_v<K> or std::is_enum_v<K>) and
+                     (sizeof(K) <= 8);
+
+template <typename T>
+concept select_value = std::is_trivially_copyable_v<T>;
+
+enum struct select_condition { eq, lt };
+
+// keys are widened to 64 bits, keeping the sign of signed keys so that the
+// comparison is unchanged
+template <typename K> static inline auto select_operand(K k) -> std::uint64_t {
+    if constexpr (std::is_enum_v<K>) {
+        return select_operand(static_cast<std::underlying_type_t<K>>(k));
+    } else if constexpr (std::is_signed_v<K>) {
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(k));
+    } else {
+        return static_cast<std::uint64_t>(k);
+    }
+}
+
+template <typename K> constexpr auto is_signed_select_key() -> bool {
+    if constexpr (std::is_enum_v<K>) {
+        return std::is_signed_v<std::underlying_type_t<K>>;
+    } else {
+        return std::is_signed_v<K>;
+    }
+}
+
+/// first if the condition holds, otherwise second, with a conditional move
+/// (x86-64 cmov or AArch64 csel) rather than a branch
+template <select_condition C, bool Signed>
+static inline auto cmov(std::uint64_t lhs, std::uint64_t rhs,
+                        std::uint64_t first, std::uint64_t second)
+    -> std::uint64_t {
+    auto result = second;
+#if defined(__x86_64__)
+    if constexpr (C == select_condition::eq) {
+        asm("cmpq %[rhs], %[lhs]          \n\t"
+            "cmoveq %[first], %[result]   \n\t"
+            : [result] "+r"(result)
+            : [lhs] "r"(lhs), [rhs] "rm"(rhs), [first] "rm"(first)
+            : "cc");
+    } else if constexpr (Signed) {
+        asm("cmpq %[rhs], %[lhs]          \n\t"
+            "cmovlq %[first], %[result]   \n\t"
+            : [result] "+r"(result)
+            : [lhs] "r"(lhs), [rhs] "rm"(rhs), [first] "rm"(first)
+            : "cc");
+    } else {
+        asm("cmpq %[rhs], %[lhs]          \n\t"
+            "cmovbq %[first], %[result]   \n\t"
+            : [result] "+r"(result)
+            : [lhs] "r"(lhs), [rhs] "rm"(rhs), [first] "rm"(first)
+            : "cc");
+    }
+#else
+    if constexpr (C == select_condition::eq) {
+        asm("cmp %x[lhs], %x[rhs]                          \n\t"
+            "csel %x[result], %x[first], %x[result], eq    \n\t"
+            : [result] "+r"(result)
+            : [lhs] "r"(lhs), [rhs] "r"(rhs), [first] "r"(first)
+            : "cc");
+    } else if constexpr (Signed) {
+        asm("cmp %x[lhs], %x[rhs]                          \n\t"
+            "csel %x[result], %x[first], %x[result], lt    \n\t"
+            : [result] "+r"(result)
+            : [lhs] "r"(lhs), [rhs] "r"(rhs), [first] "r"(first)
+            : "cc");
+    } else {
+        asm("cmp %x[lhs], %x[rhs]                          \n\t"
+            "csel %x[result], %x[first], %x[result], lo    \n\t"
+            : [result] "+r"(result)
+            : [lhs] "r"(lhs), [rhs] "r"(rhs), [first] "r"(first)
+            : "cc");
+    }
+#endif
+    return result;
+}
+
+template <std::size_t N> struct select_word;
+template <> struct select_word<1> {
+    using type = std::uint8_t;
+};
+template <> struct select_word<2> {
+    using type = std::uint16_t;
+};
+template <> struct select_word<4> {
+    using type = std::uint32_t;
+};
+template <> struct select_word<8> {
+    using type = std::uint64_t;
+};
+
+// values that fit a register are moved directly; wider values are blended
+// word by word with a mask that is selected by a conditional move
+template <select_condition C, select_key K, select_value T>
+static inline auto branchless_select(K lhs, K rhs, T first, T second) -> T {
+    constexpr auto is_signed = is_signed_select_key<K>();
+    auto const l = select_operand(lhs);
+    auto const r = select_operand(rhs);
+
+    if constexpr (requires { typename select_word<sizeof(T)>::type; }) {
+        using word_t = typename select_word<sizeof(T)>::type;
+        auto const result = cmov<C, is_signed>(
+            l, r, std::bit_cast<word_t>(first), std::bit_cast<word_t>(second));
+        return std::bit_cast<T>(static_cast<word_t>(result));
+    } else {
+        auto const mask = cmov<C, is_signed>(l, r, ~std::uint64_t{}, 0);
+
+        constexpr auto num_words = (sizeof(T) + 7) / 8;
+        std::array<std::uint64_t, num_words> f{};
+        std::array<std::uint64_t, num_words> s{};
+        std::memcpy(f.data(), &first, sizeof(T));
+        std::memcpy(s.data(), &second, sizeof(T));
+        for (auto i = std::size_t{}; i < num_words; ++i) {
+            s[i] = (f[i] & mask) | (s[i] & ~mask);
+        }
+        std::memcpy(&second, s.data(), sizeof(T));
+        return second;
+    }
+}
+
+template <select_key K, select_value T>
+static inline auto optimized_select(K lhs, K rhs, T first, T second) -> T {
+    return branchless_select<select_condition::eq>(lhs, rhs, first, second);
+}
+
+template <select_key K, select_value T>
+static inline auto optimized_select_lt(K lhs, K rhs, T first, T second) -> T {
+    return branchless_select<select_condition::lt>(lhs, rhs, first, second);
+}
 #endif
 
 template <typename K, typename T>
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) or defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lookup::detail {
+// the number of bytes compared by one SIMD instruction, and the number of
+// bits of the resulting match mask that correspond to one byte of keys
+#if defined(__AVX2__)
+constexpr inline auto simd_width = std::size_t{32};
+constexpr inline auto simd_bits_per_byte = 1;
+#elif defined(__SSE2__)
+constexpr inline auto simd_width = std::size_t{16};
+constexpr inline auto simd_bits_per_byte = 1;
+#elif defined(__ARM_NEON)
+constexpr inline auto simd_width = std::size_t{16};
+constexpr inline auto simd_bits_per_byte = 4;
+#else
+constexpr inline auto simd_width = std::size_t{8};
+constexpr inline auto simd_bits_per_byte = 0;
+#endif
+
+constexpr inline auto has_simd_find = simd_bits_per_byte != 0;
+
+template <typename T>
+constexpr inline auto simd_lanes = simd_width / sizeof(T);
+
+template <typename T, std::size_t N>
+constexpr inline auto fallback_find(std::array<T, N> const &keys, T key)
+    -> std::size_t {
+    for (auto i = std::size_t{}; i < N; ++i) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    return N;
+}
+
+// NOTE: match_bits compares one block of simd_width bytes of keys against
+// the probe key and returns a mask with simd_bits_per_byte bits set for each
+// byte of a matching key
+#if defined(__AVX2__)
+template <typename T>
+inline auto match_bits(T const *keys, T key) -> std::uint32_t {
+    auto const block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(keys));
+    auto const cmp = [&] {
+        if constexpr (sizeof(T) == 1) {
+            return _mm256_cmpeq_epi8(
+                block, _mm256_set1_epi8(std::bit_cast<char>(key)));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm256_cmpeq_epi16(
+                block, _mm256_set1_epi16(std::bit_cast<short>(key)));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm256_cmpeq_epi32(
+                block, _mm256_set1_epi32(std::bit_cast<int>(key)));
+        } else {
+            return _mm256_cmpeq_epi64(
+                block, _mm256_set1_epi64x(std::bit_cast<long long>(key)));
+        }
+    }();
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(cmp));
+}
+#elif defined(__SSE2__)
+template <typename T>
+inline auto match_bits(T const *keys, T key) -> std::uint32_t {
+    auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(keys));
+    auto const cmp = [&] {
+        if constexpr (sizeof(T) == 1) {
+            return _mm_cmpeq_epi8(block,
+                                  _mm_set1_epi8(std::bit_cast<char>(key)));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm_cmpeq_epi16(block,
+                                   _mm_set1_epi16(std::bit_cast<short>(key)));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm_cmpeq_epi32(block,
+                                   _mm_set1_epi32(std::bit_cast<int>(key)));
+        } else {
+            // SSE2 has no 64-bit compare: both 32-bit halves must match
+            auto const halves = _mm_cmpeq_epi32(
+                block, _mm_set1_epi64x(std::bit_cast<long long>(key)));
+            return _mm_and_si128(
+                halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    }();
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(cmp));
+}
+#elif defined(__ARM_NEON)
+template <typename T>
+inline auto match_bits(T const *keys, T key) -> std::uint64_t {
+    auto const cmp = [&] {
+        if constexpr (sizeof(T) == 1) {
+            return vceqq_u8(vld1q_u8(keys), vdupq_n_u8(key));
+        } else if constexpr (sizeof(T) == 2) {
+            return vreinterpretq_u8_u16(
+                vceqq_u16(vld1q_u16(keys), vdupq_n_u16(key)));
+        } else if constexpr (sizeof(T) == 4) {
+            return vreinterpretq_u8_u32(
+                vceqq_u32(vld1q_u32(keys), vdupq_n_u32(key)));
+        } else {
+#if defined(__aarch64__)
+            return vreinterpretq_u8_u64(
+                vceqq_u64(vld1q_u64(keys), vdupq_n_u64(key)));
+#else
+            // AArch32 has no 64-bit compare: both 32-bit halves must match
+            auto const halves =
+                vceqq_u32(vreinterpretq_u32_u64(vld1q_u64(keys)),
+                          vreinterpretq_u32_u64(vdupq_n_u64(key)));
+            return vreinterpretq_u8_u32(vandq_u32(halves, vrev64q_u32(halves)));
+#endif
+        }
+    }();
+    // narrow each byte of the comparison to a nibble
+    auto const nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+#endif
+
+template <typename T, std::size_t N>
+inline auto optimized_find(std::array<T, N> const &keys, T key)
+    -> std::size_t {
+    if constexpr (has_simd_find) {
+        static_assert(N % simd_lanes<T> == 0,
+                      "Keys must be padded to a whole number of blocks");
+        constexpr auto bits_per_key = sizeof(T) * simd_bits_per_byte;
+        for (auto i = std::size_t{}; i < N; i += simd_lanes<T>) {
+            if (auto const bits = match_bits(&keys[i], key); bits != 0) {
+                return i + static_cast<std::size_t>(std::countr_zero(bits)) /
+                               bits_per_key;
+            }
+        }
+        return N;
+    } else {
+        return fallback_find(keys, key);
+    }
+}
+
+/// the index of the first key equal to the probe, or N if there is none
+template <typename T, std::size_t N>
+constexpr inline auto find(std::array<T, N> const &keys, T key)
+    -> std::size_t {
+    if (std::is_constant_evaluated()) {
+        return fallback_find(keys, key);
+    }
+    return optimized_find(keys, key);
+}
+} // namespace lookup::detail
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+
+namespace lookup::detail {
+// merge two sorted adjacent ranges in place by rotation, keeping equal
+// elements in their original order
+template <typename It, typename Compare>
+constexpr auto merge_in_place(It first, It middle, It last, Compare comp)
+    -> void {
+    auto const len1 = std::distance(first, middle);
+    auto const len2 = std::distance(middle, last);
+    if (len1 == 0 or len2 == 0) {
+        return;
+    }
+    if (len1 + len2 == 2) {
+        if (comp(*middle, *first)) {
+            std::iter_swap(first, middle);
+        }
+        return;
+    }
+
+    auto cut1 = first;
+    auto cut2 = middle;
+    if (len1 > len2) {
+        cut1 = std::next(first, len1 / 2);
+        cut2 = std::lower_bound(middle, last, *cut1, comp);
+    } else {
+        cut2 = std::next(middle, len2 / 2);
+        cut1 = std::upper_bound(first, middle, *cut2, comp);
+    }
+    auto const new_middle = std::rotate(cut1, middle, cut2);
+    detail::merge_in_place(first, cut1, new_middle, comp);
+    detail::merge_in_place(new_middle, cut2, last, comp);
+}
+
+/// a stable sort that needs no buffer: std::stable_sort is not constexpr in
+/// C++20, and layouts built at compile time must match those built at runtime
+template <typename It, typename Compare>
+constexpr auto stable_sort(It first, It last, Compare comp) -> void {
+    auto const len = std::distance(first, last);
+    if (len < 16) {
+        for (auto i = first; i != last; ++i) {
+            std::rotate(std::upper_bound(first, i, *i, comp), i,
+                        std::next(i));
+        }
+        return;
+    }
+    auto const middle = std::next(first, len / 2);
+    detail::stable_sort(first, middle, comp);
+    detail::stable_sort(middle, last, comp);
+    detail::merge_in_place(first, middle, last, comp);
+}
+} // namespace lookup::detail
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <lookup/detail/pext.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <cstddef>
+
+namespace lookup {
+// hw_pext_lookup builds the same tables as pseudo_pext_lookup, but extracts
+// the masked key bits exactly with BMI2 pext instead of with a multiply.
+// Exact extraction never merges keys that differ in the masked bits, so the
+// mask search can find smaller masks. Targets built without BMI2 keep the
+// multiply: extracting each stretch of the mask with a shift costs more.
+#if defined(__BMI2__)
+template <bool Indirect = false, std::size_t MaxSearchLen = 1>
+using hw_pext_lookup =
+    pseudo_pext_lookup<Indirect, MaxSearchLen, detail::hw_pext_t>;
+#else
+template <bool Indirect = false, std::size_t MaxSearchLen = 1>
+using hw_pext_lookup = pseudo_pext_lookup<Indirect, MaxSearchLen>;
+#endif
+} // namespace lookup
@@ -0,0 +1,76 @@
+#pragma once
+#include <lookup/cost.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace lookup {
+/// what a built lookup table looks like: the strategy that built it (with the
+/// strategies it wraps in parentheses), the bytes it occupies, the key bits
+/// that it extracts if it is a pext table, and the probes into its storage
+/// to find a key, in the worst case and averaged over the keys in the table
+struct table_info {
+    constexpr static auto max_name_length = std::size_t{96};
+
+    std::array<char, max_name_length> name{};
+    std::size_t name_length{};
+    std::size_t bytes{};
+    std::uint64_t mask{};
+    std::size_t max_probes{};
+    double average_probes{};
+
+    constexpr table_info() = default;
+    constexpr table_info(std::string_view strategy_name, std::size_t b,
+                         std::uint64_t m, std::size_t max_p, double average_p)
+        : bytes{b}, mask{m}, max_probes{max_p}, average_probes{average_p} {
+        append(strategy_name);
+    }
+
+    [[nodiscard]] constexpr auto strategy() const -> std::string_view {
+        return {name.data(), name_length};
+    }
+
+    /// this table inside a wrapper that adds its own bytes and probes; the
+    /// name becomes "outer(inner)"
+    [[nodiscard]] constexpr auto wrapped(std::string_view outer,
+                                         std::size_t outer_bytes,
+                                         std::size_t extra_probes) const
+        -> table_info {
+        auto t = table_info{outer, outer_bytes, mask,
+                            max_probes + extra_probes,
+                            average_probes +
+                                static_cast<double>(extra_probes)};
+        t.append("(");
+        t.append(strategy());
+        t.append(")");
+        return t;
+    }
+
+    constexpr auto append(std::string_view s) -> void {
+        for (auto c : s) {
+            if (name_length < max_name_length) {
+                name[name_length++] = c;
+            }
+        }
+    }
+};
+
+template <typename T>
+concept described = requires(T const &t) {
+    { t.info() } -> std::same_as<table_info>;
+};
+
+/// tables that do not describe themselves are reported by their cost
+template <typename T>
+[[nodiscard]] constexpr auto info(T const &t) -> table_info {
+    if constexpr (described<T>) {
+        return t.info();
+    } else {
+        auto const c = cost(t);
+        return {"", c.bytes, 0, c.probes, static_cast<double>(c.probes)};
+    }
+}
+} // namespace lookup
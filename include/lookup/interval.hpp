@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace lookup {
+/// a half-open range of keys [lo, hi) that maps to a value
+template <typename K, typename V> struct interval {
+    using key_type = K;
+    using value_type = V;
+    key_type lo_{};
+    key_type hi_{};
+    value_type value_{};
+};
+template <typename K, typename V> interval(K, K, V) -> interval<K, V>;
+
+template <typename K, typename V = K, std::size_t N = 0> struct interval_input {
+    using key_type = K;
+    using value_type = V;
+
+    using array_t = std::array<interval<K, V>, N>;
+    constexpr static auto size = std::integral_constant<std::size_t, N>{};
+
+    constexpr interval_input() = default;
+    constexpr explicit interval_input(value_type const &v) : default_value{v} {}
+    constexpr interval_input(value_type const &v, array_t const &a)
+        : default_value{v}, entries{a} {}
+
+    V default_value{};
+    std::array<interval<K, V>, N> entries{};
+};
+
+template <typename V, typename A>
+interval_input(V, A) -> interval_input<typename A::value_type::key_type,
+                                       typename A::value_type::value_type,
+                                       std::size(A{})>;
+
+template <typename V> interval_input(V) -> interval_input<V>;
+} // namespace lookup
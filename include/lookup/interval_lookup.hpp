@@ -0,0 +1,140 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/detail/select.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/interval.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+template <typename Input>
+constexpr auto sorted_intervals(Input const &input) -> typename Input::array_t {
+    auto intervals = input.entries;
+    std::sort(intervals.begin(), intervals.end(),
+              [](auto const &lhs, auto const &rhs) {
+                  return as_ordered_integral(lhs.lo_) <
+                         as_ordered_integral(rhs.lo_);
+              });
+    return intervals;
+}
+
+template <typename Input>
+constexpr auto intervals_are_valid(Input const &input) -> bool {
+    return std::all_of(input.entries.begin(), input.entries.end(),
+                       [](auto const &i) {
+                           return as_ordered_integral(i.lo_) <
+                                  as_ordered_integral(i.hi_);
+                       });
+}
+
+template <typename Input>
+constexpr auto intervals_are_disjoint(Input const &input) -> bool {
+    auto const intervals = sorted_intervals(input);
+    return std::adjacent_find(intervals.begin(), intervals.end(),
+                              [](auto const &lhs, auto const &rhs) {
+                                  return as_ordered_integral(rhs.lo_) <
+                                         as_ordered_integral(lhs.hi_);
+                              }) == intervals.end();
+}
+
+/// the number of boundaries between segments: each interval opens a segment
+/// at lo and closes it at hi, unless the next interval starts there
+template <typename Input>
+constexpr auto count_boundaries(Input const &input) -> std::size_t {
+    auto const intervals = sorted_intervals(input);
+    auto n = std::size_t{};
+    for (auto i = std::size_t{}; i < intervals.size(); ++i) {
+        auto const abuts =
+            i + 1 < intervals.size() and
+            as_ordered_integral(intervals[i].hi_) ==
+                as_ordered_integral(intervals[i + 1].lo_);
+        n += abuts ? 1 : 2;
+    }
+    return n;
+}
+} // namespace detail
+
+struct interval_lookup {
+  private:
+    // boundaries are sorted and padded with the largest key to one less than
+    // a power of two, so that the search is a fixed number of halvings;
+    // values[i] is the value of keys with i boundaries at or below them
+    template <typename Key, typename Value, std::size_t Size> struct impl {
+        using key_type = Key;
+        using value_type = Value;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+
+        std::array<raw_key_type, Size> boundaries;
+        std::array<value_type, Size + 1> values;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const k = detail::as_ordered_integral(key);
+            auto pos = std::size_t{};
+            for (auto step = (Size + 1) / 2; step > 0; step /= 2) {
+                pos = detail::select_lt(k, boundaries[pos + step - 1], pos,
+                                        pos + step);
+            }
+            return values[pos];
+        }
+
+        // one compare and select per level of the search, then a value load
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            constexpr auto levels =
+                static_cast<std::size_t>(std::bit_width(Size));
+            return {sizeof(*this), levels + 1, 3 * levels + 1};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            auto const probes = cost().probes;
+            return {"interval", sizeof(*this), 0, probes,
+                    static_cast<double>(probes)};
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using input_t = std::remove_cv_t<decltype(input)>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+
+        static_assert(detail::intervals_are_valid(input),
+                      "Lookup intervals must not be empty.");
+        static_assert(detail::intervals_are_disjoint(input),
+                      "Lookup intervals must not overlap.");
+
+        constexpr auto num_boundaries = detail::count_boundaries(input);
+        constexpr auto size = std::bit_ceil(num_boundaries + 1) - 1;
+
+        using impl_t = impl<key_type, value_type, size>;
+        auto boundaries = std::array<raw_key_type, size>{};
+        auto values = std::array<value_type, size + 1>{};
+        boundaries.fill(std::numeric_limits<raw_key_type>::max());
+        values.fill(input.default_value);
+
+        auto const intervals = detail::sorted_intervals(input);
+        auto b = std::size_t{};
+        for (auto j = std::size_t{}; j < intervals.size(); ++j) {
+            auto const lo = detail::as_ordered_integral(intervals[j].lo_);
+            auto const hi = detail::as_ordered_integral(intervals[j].hi_);
+            if (b == 0 or boundaries[b - 1] != lo) {
+                boundaries[b++] = lo;
+            }
+            values[b] = intervals[j].value_;
+            boundaries[b++] = hi;
+        }
+        return impl_t{boundaries, values};
+    }
+};
+} // namespace lookup
@@ -1,9 +1,14 @@
 #pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/batch.hpp>
 #include <lookup/detail/select.hpp>
+#include <lookup/info.hpp>
 #include <lookup/input.hpp>
 #include <lookup/strategy_failed.hpp>
 
+#include <array>
 #include <cstddef>
+#include <span>
 #include <type_traits>
 
 namespace lookup {
@@ -21,6 +26,42 @@ template <std::size_t MaxSize> struct linear_search_lookup {
             }
             return result;
         }
+
+        // every entry is loaded, compared and selected
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), Input::size, 3 * Input::size + 1};
+        }
+
+        // the search does not stop at a match
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {"linear_search", sizeof(*this), 0, Input::size,
+                    static_cast<double>(Input::size)};
+        }
+
+        // each entry's key is broadcast and compared against a chunk of
+        // probe keys at once; the plain select is left for the compiler to
+        // vectorize as a blend
+        constexpr auto batch(std::span<key_type const> keys,
+                             std::span<value_type> values) const -> void {
+            constexpr auto lanes = detail::batch_lanes;
+            auto i = std::size_t{};
+            for (; i + lanes <= keys.size(); i += lanes) {
+                std::array<value_type, lanes> results{};
+                results.fill(this->default_value);
+                for (auto [k, v] : this->entries) {
+                    for (auto j = std::size_t{}; j < lanes; ++j) {
+                        results[j] = detail::fallback_select(keys[i + j], k, v,
+                                                             results[j]);
+                    }
+                }
+                for (auto j = std::size_t{}; j < lanes; ++j) {
+                    values[i + j] = results[j];
+                }
+            }
+            for (; i < keys.size(); ++i) {
+                values[i] = (*this)[keys[i]];
+            }
+        }
     };
 
   public:
@@ -1,13 +1,60 @@
 #pragma once
 
+#include <lookup/cost.hpp>
+#include <lookup/dense_array_lookup.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/detail/simd.hpp>
 #include <lookup/input.hpp>
 #include <lookup/linear_search_lookup.hpp>
+#include <lookup/multiword_pext_lookup.hpp>
 #include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/radix_trie_lookup.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
 #include <lookup/strategies.hpp>
+#include <lookup/string_lookup.hpp>
+#include <lookup/two_level_lookup.hpp>
+
+#include <string_view>
+#include <type_traits>
 
 namespace lookup {
+// NOTE: keys that form a (nearly) dense range are indexed directly. On targets
+// with SIMD compares, a vectorized linear search is as fast as
+// pseudo_pext_lookup for up to 16 entries (see benchmark/lookup). Keys too
+// wide to pack have their discriminating bits extracted word by word; wide
+// composite keys are split over two levels only if that fails. String keys
+// are told apart by a few of their characters. Sparse keys whose bits cannot
+// be folded into a pseudo_pext table fall back to a radix trie. Fallbacks
+// are only built when the strategies before them have failed.
+struct default_strategy {
+    [[nodiscard]] consteval static auto make(compile_time auto input) {
+        using key_type = typename std::remove_cv_t<decltype(input())>::key_type;
+        if constexpr (std::is_same_v<key_type, std::string_view>) {
+            return string_lookup<default_strategy>::make(input);
+        } else if constexpr (detail::composite_key<key_type> and
+                      not detail::packable_key<key_type>) {
+            return strategies<first_success,
+                              multiword_pext_lookup<default_strategy>,
+                              two_level_lookup<default_strategy>>::make(input);
+        } else if constexpr (not detail::packable_key<key_type>) {
+            return multiword_pext_lookup<default_strategy>::make(input);
+        } else if constexpr (detail::has_simd_find) {
+            return strategies<first_success,
+                              strategies<dense_array_lookup<>,
+                                         simd_linear_search_lookup<16>,
+                                         pseudo_pext_lookup<true, 2>>,
+                              radix_trie_lookup<>>::make(input);
+        } else {
+            return strategies<first_success,
+                              strategies<dense_array_lookup<>,
+                                         linear_search_lookup<4>,
+                                         pseudo_pext_lookup<true, 2>>,
+                              radix_trie_lookup<>>::make(input);
+        }
+    }
+};
+
 [[nodiscard]] consteval static auto make(compile_time auto input) {
-    return strategies<linear_search_lookup<4>,
-                      pseudo_pext_lookup<true, 2>>::make(input);
+    return default_strategy::make(input);
 }
 } // namespace lookup
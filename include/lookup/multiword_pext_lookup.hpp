@@ -0,0 +1,244 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+/// pseudo_pext over each word of a wide key, with the extracted bits of every
+/// word concatenated. words with an empty mask extract nothing
+template <std::size_t W> struct multiword_pext_t {
+    struct word_t {
+        std::uint64_t mask{};
+        std::uint64_t coefficient{};
+        std::uint64_t final_mask{};
+        std::size_t gap_bits{};
+        std::size_t offset{};
+    };
+
+    std::array<word_t, W> words{};
+    std::size_t bits{};
+
+    constexpr explicit multiword_pext_t(
+        std::array<std::uint64_t, W> const &masks) {
+        for (auto w = std::size_t{}; w < W; ++w) {
+            if (masks[w] != 0) {
+                auto const p = pseudo_pext_t<std::uint64_t>{masks[w]};
+                words[w] = {p.mask, p.coefficient, p.final_mask, p.gap_bits,
+                            bits};
+                bits += static_cast<std::size_t>(std::popcount(masks[w]));
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr auto extract(std::size_t w,
+                                         std::uint64_t value) const
+        -> std::uint64_t {
+        auto const &x = words[w];
+        auto const packed = (value & x.mask) * x.coefficient;
+        return (packed >> x.gap_bits) & x.final_mask;
+    }
+
+    /// each word extracted separately, for any number of bits
+    [[nodiscard]] constexpr auto
+    extract_words(std::array<std::uint64_t, W> const &key) const
+        -> std::array<std::uint64_t, W> {
+        auto r = std::array<std::uint64_t, W>{};
+        for (auto w = std::size_t{}; w < W; ++w) {
+            r[w] = extract(w, key[w]);
+        }
+        return r;
+    }
+
+    /// the concatenated bits, when there are no more than 64 of them
+    [[nodiscard]] constexpr auto
+    operator()(std::array<std::uint64_t, W> const &key) const
+        -> std::uint64_t {
+        auto digest = std::uint64_t{};
+        for (auto w = std::size_t{}; w < W; ++w) {
+            digest |= extract(w, key[w]) << words[w].offset;
+        }
+        return digest;
+    }
+
+    /// an estimate of the instructions executed by an extraction
+    [[nodiscard]] constexpr auto instructions() const -> std::size_t {
+        return 1 + 5 * static_cast<std::size_t>(std::count_if(
+                           words.begin(), words.end(),
+                           [](auto const &x) { return x.mask != 0; }));
+    }
+};
+
+template <typename K, typename V, std::size_t S>
+constexpr auto get_key_words(std::array<entry<K, V>, S> const &entries)
+    -> std::array<key_words_t<K>, S> {
+    auto keys = std::array<key_words_t<K>, S>{};
+    std::transform(entries.begin(), entries.end(), keys.begin(),
+                   [](auto const &e) { return as_words(e.key_); });
+    return keys;
+}
+
+/// remove every bit from the masks (over all the words) that is not needed to
+/// tell the keys apart
+template <std::size_t W, std::size_t S>
+constexpr auto
+calc_multiword_masks(std::array<std::array<std::uint64_t, W>, S> const &keys)
+    -> std::array<std::uint64_t, W> {
+    using words_t = std::array<std::uint64_t, W>;
+    auto counter = multiplicity_counter<words_t, S>{};
+    auto const unique = [&](words_t const &masks) {
+        auto const extract = multiword_pext_t<W>{masks};
+        counter.reset();
+        return std::all_of(keys.begin(), keys.end(), [&](auto const &k) {
+            return counter.insert(extract.extract_words(k)) == 1;
+        });
+    };
+
+    auto masks = words_t{};
+    masks.fill(std::numeric_limits<std::uint64_t>::max());
+    for (auto w = std::size_t{}; w < W; ++w) {
+        for (auto x = std::size_t{}; x < 64; ++x) {
+            auto try_masks = masks;
+            try_masks[w] &= ~(std::uint64_t{1} << (63 - x));
+            if (unique(try_masks)) {
+                masks = try_masks;
+            }
+        }
+    }
+    return masks;
+}
+} // namespace detail
+
+/// keys wider than 64 bits (128-bit integers, std::array<std::uint32_t, N>,
+/// wide tuples) are split into 64-bit words, and only the bits of each word
+/// that tell the keys apart are extracted and concatenated into a digest of
+/// at most 64 bits. the digest is looked up by Strategy to find an entry,
+/// whose full key is compared before its value is returned
+template <typename Strategy> struct multiword_pext_lookup {
+  private:
+    template <typename I>
+    using key_t = typename std::remove_cv_t<decltype(I{}())>::key_type;
+
+    template <typename I>
+    constexpr static auto num_words = detail::num_key_words<key_t<I>>;
+
+    template <typename I>
+    constexpr static auto masks =
+        detail::calc_multiword_masks(detail::get_key_words(I{}().entries));
+
+    template <typename I>
+    constexpr static auto extract = detail::multiword_pext_t<num_words<I>>{
+        masks<I>};
+
+    template <typename I>
+    using index_t = detail::uint_for_<std::remove_cv_t<decltype(I{}())>::size>;
+
+    template <typename I>
+    using digest_t = decltype(detail::uint_for_bits_f<std::max(
+                                  extract<I>.bits, std::size_t{1})>());
+
+    template <typename I> struct digests_input {
+        using cx_value_t [[maybe_unused]] = void;
+
+        consteval auto operator()() const {
+            constexpr auto input = I{}();
+            using input_t = std::remove_cv_t<decltype(input)>;
+
+            auto entries =
+                std::array<entry<digest_t<I>, index_t<I>>, input_t::size>{};
+            for (auto i = std::size_t{}; i < input_t::size; ++i) {
+                entries[i] = {static_cast<digest_t<I>>(extract<I>(
+                                  detail::as_words(input.entries[i].key_))),
+                              static_cast<index_t<I>>(i)};
+            }
+            return lookup::input{static_cast<index_t<I>>(input_t::size),
+                                 entries};
+        }
+    };
+
+    template <typename Key, typename Value, typename Extract, typename Digests,
+              std::size_t S>
+    struct impl {
+        using key_type = Key;
+        using value_type = Value;
+        using words_t = detail::key_words_t<key_type>;
+        using digest_type = typename Digests::key_type;
+
+        Extract extract;
+        Digests digests;
+        // the last entry holds the default value
+        std::array<entry<words_t, value_type>, S + 1> storage;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const words = detail::as_words(key);
+            auto const &e =
+                storage[digests[static_cast<digest_type>(extract(words))]];
+            return e.key_ == words ? e.value_ : storage[S].value_;
+        }
+
+        // extract, look up the digest, then compare the full key
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            auto const c = lookup::cost(digests);
+            return {sizeof(*this), c.probes + 1,
+                    extract.instructions() + c.instructions +
+                        2 * std::tuple_size_v<words_t> + 1};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return lookup::info(digests).wrapped("multiword_pext",
+                                                 sizeof(*this), 1);
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        using I = decltype(i);
+        using input_t = std::remove_cv_t<decltype(i())>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+
+        constexpr auto input = i();
+        static_assert(
+            detail::keys_are_unique(detail::get_key_words(input.entries)),
+            "Lookup keys must be unique.");
+
+        if constexpr (extract<I>.bits > 64) {
+            return strategy_failed_t{};
+        } else {
+            constexpr auto digests = Strategy::make(digests_input<I>{});
+            if constexpr (strategy_failed(digests)) {
+                return strategy_failed_t{};
+            } else {
+                constexpr auto storage = [&] {
+                    auto s = std::array<
+                        entry<detail::key_words_t<key_type>, value_type>,
+                        input_t::size + 1>{};
+                    for (auto j = std::size_t{}; j < input_t::size; ++j) {
+                        s[j] = {detail::as_words(input.entries[j].key_),
+                                input.entries[j].value_};
+                    }
+                    s[input_t::size].value_ = input.default_value;
+                    return s;
+                }();
+                return impl<key_type, value_type,
+                            std::remove_cv_t<decltype(extract<I>)>,
+                            std::remove_cv_t<decltype(digests)>,
+                            input_t::size>{extract<I>, digests, storage};
+            }
+        }
+    }
+};
+} // namespace lookup
@@ -0,0 +1,227 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+/// multiply-xorshift hash of a key: the high half selects a bucket and the
+/// low half, remixed by the bucket's seed, selects a slot
+constexpr auto phash(std::uint64_t key) -> std::uint64_t {
+    auto const h = key * 0x9e37'79b9'7f4a'7c15u;
+    return h ^ (h >> 32u);
+}
+
+/// map a 32-bit hash onto [0, n) without a division
+constexpr auto fastrange(std::uint32_t h, std::size_t n) -> std::size_t {
+    return static_cast<std::size_t>((std::uint64_t{h} * n) >> 32u);
+}
+
+constexpr auto phash_bucket(std::uint64_t h, std::size_t num_buckets)
+    -> std::size_t {
+    return fastrange(static_cast<std::uint32_t>(h >> 32u), num_buckets);
+}
+
+constexpr auto phash_slot(std::uint64_t h, std::uint32_t seed,
+                          std::size_t num_slots) -> std::size_t {
+    // an odd multiplier is a bijection, so keys with distinct hashes move
+    // independently for each seed
+    auto const multiplier =
+        static_cast<std::uint32_t>((2u * seed + 1u) * 0x85eb'ca6bu);
+    return fastrange(static_cast<std::uint32_t>(h) * multiplier, num_slots);
+}
+
+template <std::size_t NumBuckets> struct phash_seeds_t {
+    bool found{};
+    std::uint32_t max_seed{};
+    std::array<std::uint32_t, NumBuckets> seeds{};
+};
+
+/// hash-and-displace: keys are grouped into buckets by one hash, and each
+/// bucket, largest first, searches for a seed that places all of its keys in
+/// free slots
+template <std::size_t NumBuckets, std::size_t NumSlots, typename T,
+          std::size_t N>
+constexpr auto find_phash_seeds(std::array<T, N> const &keys,
+                                std::uint32_t max_tries)
+    -> phash_seeds_t<NumBuckets> {
+    auto result = phash_seeds_t<NumBuckets>{};
+
+    // counting sort of key indices by bucket
+    std::array<std::size_t, NumBuckets + 1> offsets{};
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, N> bucket_of{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        hashes[i] = phash(keys[i]);
+        bucket_of[i] = phash_bucket(hashes[i], NumBuckets);
+        ++offsets[bucket_of[i] + 1];
+    }
+    for (auto b = std::size_t{}; b < NumBuckets; ++b) {
+        offsets[b + 1] += offsets[b];
+    }
+    std::array<std::size_t, N> members{};
+    auto fill = offsets;
+    for (auto i = std::size_t{}; i < N; ++i) {
+        members[fill[bucket_of[i]]++] = i;
+    }
+
+    std::array<std::size_t, NumBuckets> order{};
+    for (auto b = std::size_t{}; b < NumBuckets; ++b) {
+        order[b] = b;
+    }
+    std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+        auto const lhs_size = offsets[lhs + 1] - offsets[lhs];
+        auto const rhs_size = offsets[rhs + 1] - offsets[rhs];
+        return lhs_size > rhs_size or (lhs_size == rhs_size and lhs < rhs);
+    });
+
+    std::array<bool, NumSlots> taken{};
+    for (auto b : order) {
+        auto const first = offsets[b];
+        auto const last = offsets[b + 1];
+        if (first == last) {
+            break;
+        }
+
+        auto placed = false;
+        for (auto seed = std::uint32_t{}; seed < max_tries and not placed;
+             ++seed) {
+            auto i = first;
+            for (; i < last; ++i) {
+                auto const s = phash_slot(hashes[members[i]], seed, NumSlots);
+                if (taken[s]) {
+                    break;
+                }
+                taken[s] = true;
+            }
+            placed = i == last;
+            if (placed) {
+                result.seeds[b] = seed;
+                result.max_seed = std::max(result.max_seed, seed);
+            } else {
+                // roll back the slots taken by this attempt
+                for (auto j = first; j < i; ++j) {
+                    taken[phash_slot(hashes[members[j]], seed, NumSlots)] =
+                        false;
+                }
+            }
+        }
+        if (not placed) {
+            return result;
+        }
+    }
+
+    result.found = true;
+    return result;
+}
+} // namespace detail
+
+template <std::size_t SlotsPercent = 120, std::size_t KeysPerBucket = 2>
+struct perfect_hash_lookup {
+  private:
+    static_assert(SlotsPercent >= 100);
+    static_assert(KeysPerBucket > 0);
+
+    constexpr static auto max_tries = std::uint32_t{1} << 16u;
+
+    template <typename Key, typename Value, typename Seeds, typename Storage>
+    struct impl {
+        using key_type = Key;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = Value;
+
+        value_type default_value;
+        Seeds seeds;
+        Storage storage;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const raw_key = detail::as_raw_integral(key);
+            auto const h = detail::phash(raw_key);
+            auto const bucket = detail::phash_bucket(h, seeds.size());
+            auto const slot =
+                detail::phash_slot(h, seeds[bucket], storage.size());
+            auto const e = storage[slot];
+
+            if (raw_key == e.key_) {
+                return e.value_;
+            }
+
+            return default_value;
+        }
+
+        // hash, bucket, seed load, slot, entry load and select
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), 2, 15};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {"perfect_hash", sizeof(*this), 0, 2, 2};
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using key_type = typename decltype(input)::key_type;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = typename decltype(input)::value_type;
+
+        constexpr auto keys = detail::get_keys(input.entries);
+        static_assert(detail::keys_are_unique(keys),
+                      "Lookup keys must be unique.");
+
+        constexpr auto num_buckets =
+            std::max(std::size_t{1},
+                     (keys.size() + KeysPerBucket - 1) / KeysPerBucket);
+        constexpr auto num_slots = std::max(
+            std::size_t{1}, (keys.size() * SlotsPercent + 99) / 100);
+
+        constexpr auto result =
+            detail::find_phash_seeds<num_buckets, num_slots>(keys, max_tries);
+
+        if constexpr (not result.found) {
+            return strategy_failed_t{};
+        } else {
+            using seed_t = detail::uint_for_<result.max_seed>;
+            using seeds_t = std::array<seed_t, num_buckets>;
+            using storage_t =
+                std::array<entry<raw_key_type, value_type>, num_slots>;
+
+            constexpr auto seeds = [&] {
+                seeds_t s{};
+                for (auto b = std::size_t{}; b < num_buckets; ++b) {
+                    s[b] = static_cast<seed_t>(result.seeds[b]);
+                }
+                return s;
+            }();
+
+            // an empty slot holds the default value, so a probe that lands on
+            // it gets the default whether or not the stored key matches
+            constexpr auto storage = [&] {
+                storage_t s{};
+                s.fill({raw_key_type{}, input.default_value});
+                for (auto e : input.entries) {
+                    auto const k = detail::as_raw_integral(e.key_);
+                    auto const h = detail::phash(k);
+                    auto const seed =
+                        seeds[detail::phash_bucket(h, num_buckets)];
+                    s[detail::phash_slot(h, seed, num_slots)] = {k, e.value_};
+                }
+                return s;
+            }();
+
+            return impl<key_type, value_type, seeds_t, storage_t>{
+                input.default_value, seeds, storage};
+        }
+    }
+};
+} // namespace lookup
@@ -0,0 +1,142 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+/// a blocked Bloom filter: each key sets NumHashes bits in a single 64-bit
+/// word, so a query is one load. the block is chosen by the top bits of the
+/// hash and each bit position by the next six bits down
+template <std::size_t Words, std::size_t NumHashes> struct bloom_filter_t {
+    static_assert(std::has_single_bit(Words));
+    constexpr static auto block_bits =
+        static_cast<std::size_t>(std::countr_zero(Words));
+    static_assert(block_bits + 6 * NumHashes <= 64);
+
+    std::array<std::uint64_t, Words> words{};
+
+    [[nodiscard]] constexpr static auto hash(std::uint64_t raw)
+        -> std::uint64_t {
+        return (raw ^ (raw >> 32u)) * 0x9e37'79b9'7f4a'7c15u;
+    }
+
+    [[nodiscard]] constexpr static auto block(std::uint64_t h) -> std::size_t {
+        if constexpr (block_bits == 0) {
+            return 0;
+        } else {
+            return static_cast<std::size_t>(h >> (64 - block_bits));
+        }
+    }
+
+    [[nodiscard]] constexpr static auto bits(std::uint64_t h)
+        -> std::uint64_t {
+        auto m = std::uint64_t{};
+        for (auto i = std::size_t{}; i < NumHashes; ++i) {
+            auto const pos = (h >> (64 - block_bits - 6 * (i + 1))) & 63u;
+            m |= std::uint64_t{1} << pos;
+        }
+        return m;
+    }
+
+    constexpr auto insert(std::uint64_t raw) -> void {
+        auto const h = hash(raw);
+        words[block(h)] |= bits(h);
+    }
+
+    [[nodiscard]] constexpr auto may_contain(std::uint64_t raw) const
+        -> bool {
+        auto const h = hash(raw);
+        auto const m = bits(h);
+        return (words[block(h)] & m) == m;
+    }
+
+    /// hash, load, mask and compare
+    [[nodiscard]] constexpr static auto instructions() -> std::size_t {
+        return 6 + 2 * NumHashes;
+    }
+};
+} // namespace detail
+
+/// a Bloom filter in front of the table built by Strategy, for tables where
+/// most lookups miss: a key that the filter rejects returns the default value
+/// without touching the table. the filter has about BitsPerKey bits per entry
+/// (rounded up to a power of two words); with the defaults, about one miss in
+/// twenty gets past it
+template <typename Strategy, std::size_t BitsPerKey = 8,
+          std::size_t NumHashes = 3>
+struct prefilter_lookup {
+  private:
+    template <typename Key, typename Value, typename Filter, typename Table>
+    struct impl {
+        using key_type = Key;
+        using value_type = Value;
+
+        Filter filter;
+        Table table;
+        value_type default_value;
+
+        /// false if the key is certainly not in the table
+        [[nodiscard]] constexpr auto may_contain(key_type key) const -> bool {
+            return filter.may_contain(detail::as_raw_integral(key));
+        }
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            if (not may_contain(key)) {
+                return default_value;
+            }
+            return table[key];
+        }
+
+        // the filter costs a probe of its own ahead of the table's
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            auto const c = lookup::cost(table);
+            return {sizeof(*this), c.probes + 1,
+                    c.instructions + Filter::instructions() + 1};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return lookup::info(table).wrapped("prefilter", sizeof(*this), 1);
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using input_t = std::remove_cv_t<decltype(input)>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+        static_assert(detail::packable_key<key_type>,
+                      "prefilter_lookup needs keys that fit in 64 bits.");
+
+        constexpr auto table = Strategy::make(i);
+        if constexpr (strategy_failed(table)) {
+            return strategy_failed_t{};
+        } else {
+            constexpr auto num_words =
+                std::bit_ceil((input_t::size * BitsPerKey + 63) / 64);
+            using filter_t = detail::bloom_filter_t<num_words, NumHashes>;
+
+            constexpr auto filter = [&] {
+                auto f = filter_t{};
+                for (auto const &e : input.entries) {
+                    f.insert(detail::as_raw_integral(e.key_));
+                }
+                return f;
+            }();
+            return impl<key_type, value_type, filter_t,
+                        std::remove_cv_t<decltype(table)>>{
+                filter, table, input.default_value};
+        }
+    }
+};
+} // namespace lookup
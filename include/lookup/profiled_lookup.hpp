@@ -0,0 +1,63 @@
+#pragma once
+#include <lookup/detail/sort.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lookup {
+/// how often each key was looked up, e.g. as counted by an instrumented build
+/// and written out as a header. keys that are missing count as never seen
+template <typename K, std::size_t N>
+using profile = std::array<entry<K, std::uint64_t>, N>;
+
+/// the table built by Strategy from the entries ordered most frequent first
+/// (keys seen equally often keep their order). a linear search then meets
+/// the hot keys first, and where keys collide in an indirect pseudo_pext
+/// bucket the most frequent is compared first. lookups return the same
+/// values whatever the profile says
+template <typename Strategy, auto Profile> struct profiled_lookup {
+  private:
+    template <typename K>
+    constexpr static auto frequency(K const &key) -> std::uint64_t {
+        for (auto const &[k, n] : Profile) {
+            if (k == key) {
+                return n;
+            }
+        }
+        return 0;
+    }
+
+    template <typename I> struct ordered_input {
+        using cx_value_t [[maybe_unused]] = void;
+
+        consteval auto operator()() const {
+            constexpr auto input = I{}();
+            using input_t = std::remove_cv_t<decltype(input)>;
+
+            auto ranks =
+                std::array<entry<std::uint64_t, std::size_t>, input_t::size>{};
+            for (auto i = std::size_t{}; i < input_t::size; ++i) {
+                ranks[i] = {frequency(input.entries[i].key_), i};
+            }
+            detail::stable_sort(
+                ranks.begin(), ranks.end(),
+                [](auto const &l, auto const &r) { return l.key_ > r.key_; });
+
+            auto ordered = input;
+            for (auto i = std::size_t{}; i < input_t::size; ++i) {
+                ordered.entries[i] = input.entries[ranks[i].value_];
+            }
+            return ordered;
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        return Strategy::make(ordered_input<decltype(i)>{});
+    }
+};
+} // namespace lookup
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <lookup/cost.hpp>
+#include <lookup/detail/batch.hpp>
+#include <lookup/detail/key.hpp>
 #include <lookup/detail/select.hpp>
+#include <lookup/detail/sort.hpp>
+#include <lookup/info.hpp>
 #include <lookup/input.hpp>
 #include <lookup/strategy_failed.hpp>
 
@@ -16,31 +21,14 @@
 #include <cstdint>
 #include <iterator>
 #include <limits>
+#include <span>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 
 namespace lookup {
 
 namespace detail {
-constexpr auto as_raw_integral(auto v) {
-    static_assert(sizeof(v) <= 8);
-
-    if constexpr (sizeof(v) == 1) {
-        return std::bit_cast<std::uint8_t>(v);
-
-    } else if constexpr (sizeof(v) == 2) {
-        return std::bit_cast<std::uint16_t>(v);
-
-    } else if constexpr (sizeof(v) <= 4) {
-        return std::bit_cast<std::uint32_t>(v);
-
-    } else if constexpr (sizeof(v) <= 8) {
-        return std::bit_cast<std::uint64_t>(v);
-    }
-}
-
-template <typename T>
-using raw_integral_t = decltype(as_raw_integral(std::declval<T>()));
-
 template <uint64_t BiggestValue> auto uint_for_f() {
     if constexpr (BiggestValue <= std::numeric_limits<uint8_t>::max()) {
         return uint8_t{};
@@ -59,31 +47,24 @@ template <uint64_t BiggestValue> auto uint_for_f() {
 template <uint64_t BiggestValue>
 using uint_for_ = decltype(uint_for_f<BiggestValue>());
 
-/// log n
+/// one coefficient bit per stretch of mask bits: it shifts the stretch down
+/// to dst, just above the stretches below it. the mask search builds one of
+/// these for every candidate mask, so it uses plain integer operations
+/// (a few per stretch) to stay cheap at compile time
 template <typename T>
 constexpr auto compute_pack_coefficient(std::size_t dst, T const mask) -> T {
-    constexpr auto t_digits = std::numeric_limits<T>::digits;
-
-    auto pack_coefficient = stdx::bitset<t_digits>{};
-    auto const mask_bits = stdx::bitset<t_digits>{mask};
-
-    bool prev_src_bit_set = false;
-    for (auto src = std::size_t{}; src < t_digits; src++) {
-        bool const curr_src_bit_set = mask_bits[src];
-        bool const new_stretch = curr_src_bit_set and not prev_src_bit_set;
-
-        if (new_stretch) {
-            pack_coefficient.set(dst - src);
-        }
-
-        if (curr_src_bit_set) {
-            dst += 1;
-        }
-
-        prev_src_bit_set = curr_src_bit_set;
+    auto pack_coefficient = T{};
+    auto remaining = mask;
+    while (remaining != 0) {
+        auto const src = static_cast<std::size_t>(std::countr_zero(remaining));
+        auto const len = static_cast<std::size_t>(
+            std::countr_one(static_cast<T>(remaining >> src)));
+        pack_coefficient |= static_cast<T>(T{1} << (dst - src));
+        dst += len;
+        // clear the stretch: the bits from src up to src + len
+        remaining &= static_cast<T>(remaining + static_cast<T>(T{1} << src));
     }
-
-    return pack_coefficient.template to<T>();
+    return pack_coefficient;
 }
 
 template <typename T> struct pseudo_pext_t {
@@ -104,69 +85,121 @@ template <typename T> struct pseudo_pext_t {
         final_mask = stdx::bit_mask<T>(final_mask_msb);
     }
 
+    [[nodiscard]] constexpr static auto name() -> std::string_view {
+        return "pseudo_pext";
+    }
+
+    /// an estimate of the instructions executed by an extraction
+    [[nodiscard]] constexpr static auto instructions() -> std::size_t {
+        return 4;
+    }
+
     [[nodiscard]] constexpr auto operator()(T value) const -> T {
         auto const packed = (value & mask) * coefficient;
         return static_cast<T>(packed >> gap_bits) & final_mask;
     }
 };
 
-/// count the number of key duplicates (n log n)
-template <typename T, std::size_t S>
-constexpr auto count_duplicates(std::array<T, S> keys) -> std::size_t {
-    std::sort(std::begin(keys), std::end(keys));
-    auto dups = std::size_t{};
-    for (auto i = std::adjacent_find(std::cbegin(keys), std::cend(keys));
-         i != std::cend(keys); i = std::adjacent_find(++i, std::cend(keys))) {
-        ++dups;
+template <typename T> struct multiplicity_slot {
+    T key;
+    std::size_t generation;
+    std::size_t count;
+};
+
+/// integral keys are hashed as they are; the words of wide keys are mixed
+template <typename T>
+constexpr auto counter_hash(T const &key) -> std::uint64_t {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<std::uint64_t>(key);
+    } else {
+        auto h = std::uint64_t{};
+        for (auto w : key) {
+            h = (h ^ static_cast<std::uint64_t>(w)) * 0xff51'afd7'ed55'8ccdu;
+        }
+        return h;
     }
-    return dups;
 }
 
-/// count the length of the longest run of identical values (n)
-template <typename T, std::size_t S>
-constexpr auto count_longest_run(std::array<T, S> keys) -> std::size_t {
-    std::sort(keys.begin(), keys.end());
-
-    auto longest_run = std::size_t{};
-    auto current_run = std::size_t{};
-
-    if (S > 0) {
-        T prev_value = keys[0];
-
-        for (auto i = std::size_t{1}; i < S; i++) {
-            T const curr_value = keys[i];
+/// a power of two with room for twice as many keys
+constexpr auto multiplicity_capacity(std::size_t num_keys) -> std::size_t {
+    return std::bit_ceil(std::max(2 * num_keys, std::size_t{2}));
+}
 
-            if (curr_value == prev_value) {
-                current_run++;
+/// counts key multiplicities in an open-addressing hash table. slots are
+/// stamped with the generation of the count that filled them, so the table is
+/// reused between counts without being cleared (n per count)
+template <typename T, typename Slots> struct basic_multiplicity_counter {
+    Slots slots{};
+    std::size_t generation{};
+
+    constexpr auto reset() -> void { ++generation; }
+
+    /// the number of times the key has been seen in this count
+    constexpr auto insert(T key) -> std::size_t {
+        auto const capacity = std::size(slots);
+        auto const shift = std::numeric_limits<std::uint64_t>::digits -
+                           std::countr_zero(capacity);
+        auto i = static_cast<std::size_t>(
+            (counter_hash(key) * 0x9e37'79b9'7f4a'7c15u) >>
+            shift);
+        while (true) {
+            auto &s = slots[i];
+            if (s.generation != generation) {
+                s = {key, generation, 1};
+                return 1;
             }
-
-            longest_run = std::max(longest_run, current_run);
-
-            if (curr_value != prev_value) {
-                current_run = 0;
+            if (s.key == key) {
+                return ++s.count;
             }
+            i = (i + 1) & (capacity - 1);
+        }
+    }
+};
 
-            prev_value = curr_value;
+template <typename T, std::size_t S>
+using multiplicity_counter = basic_multiplicity_counter<
+    T, std::array<multiplicity_slot<T>, multiplicity_capacity(S)>>;
+
+/// count the number of key duplicates after extraction with a mask, stopping
+/// once the count reaches the limit (n)
+template <template <typename> typename Extract, typename T, typename Keys,
+          typename Counter>
+constexpr auto
+count_duplicates(T const mask, Keys const &keys, Counter &counter,
+                 std::size_t limit = std::numeric_limits<std::size_t>::max())
+    -> std::size_t {
+    auto const extract = Extract<T>(mask);
+    counter.reset();
+    auto dups = std::size_t{};
+    for (auto k : keys) {
+        if (counter.insert(extract(k)) > 1 and ++dups >= limit) {
+            break;
         }
     }
+    return dups;
+}
 
+/// count the length of the longest run of identical keys after extraction
+/// with a mask (n)
+template <template <typename> typename Extract, typename T, typename Keys,
+          typename Counter>
+constexpr auto count_longest_run(T const mask, Keys const &keys,
+                                 Counter &counter) -> std::size_t {
+    auto const extract = Extract<T>(mask);
+    counter.reset();
+    auto longest_run = std::size_t{};
+    for (auto k : keys) {
+        longest_run = std::max(longest_run, counter.insert(extract(k)) - 1);
+    }
     return longest_run;
 }
 
 template <typename T, std::size_t S>
 constexpr auto keys_are_unique(std::array<T, S> const &keys) -> bool {
-    return count_duplicates(keys) == 0;
-}
-
-template <typename T, std::size_t S>
-constexpr auto with_mask(T const mask, std::array<T, S> const &keys)
-    -> std::array<T, S> {
-    std::array<T, S> new_keys{};
-
-    std::transform(keys.begin(), keys.end(), new_keys.begin(),
-                   [&](T k) { return pseudo_pext_t(mask)(k); });
-
-    return new_keys;
+    auto counter = multiplicity_counter<T, S>{};
+    counter.reset();
+    return std::all_of(keys.begin(), keys.end(),
+                       [&](T k) { return counter.insert(k) == 1; });
 }
 
 template <typename T, typename V, std::size_t S>
@@ -182,13 +215,11 @@ constexpr auto get_keys(std::array<entry<T, V>, S> const &entries)
     return new_keys;
 }
 
-template <typename T, std::size_t S>
-constexpr auto remove_cheapest_bit(detail::raw_integral_t<T> mask,
-                                   std::array<T, S> keys)
-    -> detail::raw_integral_t<T> {
-    using raw_t = detail::raw_integral_t<T>;
-
-    auto const t_digits = std::numeric_limits<raw_t>::digits;
+template <template <typename> typename Extract = pseudo_pext_t, typename T,
+          typename Keys, typename Counter>
+constexpr auto remove_cheapest_bit(T mask, Keys const &keys, Counter &counter)
+    -> T {
+    auto const t_digits = std::numeric_limits<T>::digits;
     auto bmask = stdx::bitset<t_digits>{mask};
 
     auto cheapest_bit = std::size_t{};
@@ -199,10 +230,10 @@ constexpr auto remove_cheapest_bit(detail::raw_integral_t<T> mask,
             auto btry_mask = bmask;
             btry_mask.reset(i);
 
-            std::array<raw_t, S> try_keys =
-                with_mask(btry_mask.template to<raw_t>(), keys);
-
-            auto num_dups = count_duplicates(try_keys);
+            // a count that reaches the current minimum cannot improve on it
+            auto const num_dups =
+                count_duplicates<Extract>(btry_mask.template to<T>(), keys,
+                                          counter, min_num_dups);
             if (num_dups < min_num_dups) {
                 min_num_dups = num_dups;
                 cheapest_bit = i;
@@ -211,16 +242,18 @@ constexpr auto remove_cheapest_bit(detail::raw_integral_t<T> mask,
         bmask);
 
     bmask.reset(cheapest_bit);
-    return bmask.template to<raw_t>();
+    return bmask.template to<T>();
 }
 
-template <typename T, typename V, std::size_t S>
-constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
-                                     std::size_t max_search_len) {
-    using raw_t = detail::raw_integral_t<T>;
-
+/// the keys are raw integrals that are known to be unique; the counter has
+/// room for all of them
+template <template <typename> typename Extract = pseudo_pext_t, typename Keys,
+          typename Counter>
+constexpr auto calc_pseudo_pext_mask_for_keys(Keys const &keys,
+                                              Counter &counter,
+                                              std::size_t max_search_len) {
+    using raw_t = typename Keys::value_type;
     auto const t_digits = std::numeric_limits<raw_t>::digits;
-    std::array<raw_t, S> keys = get_keys(pairs);
 
     // try removing each bit from the mask one at a time.
     // then apply the pseudo_pext function to all the keys with the mask. if
@@ -230,8 +263,7 @@ constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
     for (auto x = std::size_t{}; x < t_digits; x++) {
         auto i = t_digits - 1 - x;
         raw_t const try_mask = mask & ~static_cast<raw_t>(raw_t{1} << i);
-        std::array<raw_t, S> const try_keys = with_mask(try_mask, keys);
-        if (keys_are_unique(try_keys)) {
+        if (count_duplicates<Extract>(try_mask, keys, counter, 1) == 0) {
             mask = try_mask;
         }
     }
@@ -243,8 +275,9 @@ constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
     // staying under the max search length.
     auto prev_longest_run = std::size_t{};
     while (max_search_len > 1 && std::popcount(mask) > 4) {
-        auto try_mask = remove_cheapest_bit(mask, keys);
-        auto current_longest_run = count_longest_run(with_mask(try_mask, keys));
+        auto try_mask = remove_cheapest_bit<Extract>(mask, keys, counter);
+        auto current_longest_run =
+            count_longest_run<Extract>(try_mask, keys, counter);
         if (current_longest_run <= max_search_len) {
             mask = try_mask;
             prev_longest_run = current_longest_run;
@@ -256,9 +289,99 @@ constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
     return std::make_tuple(mask, prev_longest_run);
 }
 
+template <template <typename> typename Extract = pseudo_pext_t, typename T,
+          typename V, std::size_t S>
+constexpr auto calc_pseudo_pext_mask(std::array<entry<T, V>, S> const &pairs,
+                                     std::size_t max_search_len) {
+    using raw_t = detail::raw_integral_t<T>;
+
+    std::array<raw_t, S> const keys = get_keys(pairs);
+    auto counter = multiplicity_counter<raw_t, S>{};
+    return calc_pseudo_pext_mask_for_keys<Extract>(keys, counter,
+                                                   max_search_len);
+}
+
+/// the probes to find each key in an indirect table, averaged over the keys:
+/// the index load, then each entry of its bucket up to its own
+template <typename Extract, typename Table, typename Entries>
+constexpr auto average_bucket_probes(Extract const &p, Table const &t,
+                                     Entries const &storage) -> double {
+    if (storage.empty()) {
+        return 0;
+    }
+    auto total = std::size_t{};
+    for (auto i = std::size_t{}; i < storage.size(); ++i) {
+        total += i + 2 - t[p(detail::as_raw_integral(storage[i].key_))];
+    }
+    return static_cast<double>(total) / static_cast<double>(storage.size());
+}
+
+/// keys whose bits cannot be folded into a table of at most this many bits
+/// (a million slots) are left to other strategies
+constexpr auto max_pseudo_pext_bits = 20;
+
+/// sort the entries by their extracted key to group each bucket together, and
+/// place the longest bucket at the end so that no search reads past the end
+template <typename Extract, typename Entries>
+constexpr auto arrange_buckets(Extract const &p, Entries &s,
+                               std::size_t search_len) -> void {
+    // entries that share a bucket stay in input order, so the earlier of two
+    // colliding keys is found with fewer probes
+    detail::stable_sort(s.begin(), s.end(), [&](auto left, auto right) {
+        return p(detail::as_raw_integral(left.key_)) <
+               p(detail::as_raw_integral(right.key_));
+    });
+
+    // find end of the longest bucket
+    auto const end_of_longest_bucket = [&]() {
+        auto e = s.begin();
+
+        auto curr_bucket_length = 1u;
+        auto prev_idx = p(detail::as_raw_integral(e->key_));
+        e++;
+        while (e != s.end()) {
+            auto const curr_idx = p(detail::as_raw_integral(e->key_));
+
+            if (curr_idx == prev_idx) {
+                curr_bucket_length++;
+
+            } else if (curr_bucket_length >= search_len) {
+                return e;
+
+            } else {
+                curr_bucket_length = 1;
+            }
+
+            prev_idx = curr_idx;
+            e++;
+        }
+
+        return e;
+    }();
+
+    std::rotate(s.begin(), end_of_longest_bucket, s.end());
+}
+
+/// each slot of the lookup table holds the index of the first entry of its
+/// bucket in the arranged storage
+template <typename Extract, typename Table, typename Entries>
+constexpr auto fill_lookup_table(Extract const &p, Table &t,
+                                 Entries const &storage) -> void {
+    using idx_t = typename Table::value_type;
+    std::fill(t.begin(), t.end(), idx_t{});
+
+    // iterate backwards so the index of the first entry of a bucket
+    // remains in the lookup table
+    for (auto entry_idx = storage.size(); entry_idx-- > 0;) {
+        auto const raw_key = detail::as_raw_integral(storage[entry_idx].key_);
+        t[p(raw_key)] = static_cast<idx_t>(entry_idx);
+    }
+}
+
 } // namespace detail
 
-template <bool Indirect = false, std::size_t MaxSearchLen = 1>
+template <bool Indirect = false, std::size_t MaxSearchLen = 1,
+          template <typename> typename Extract = detail::pseudo_pext_t>
 struct pseudo_pext_lookup {
   private:
     constexpr static bool use_indirect_strategy = Indirect;
@@ -275,6 +398,21 @@ struct pseudo_pext_lookup {
         [[nodiscard]] constexpr auto operator[](key_type) const -> value_type {
             return default_value;
         }
+
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), 0, 1};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {Extract<raw_key_type>::name(), sizeof(*this), 0, 0, 0};
+        }
+
+        constexpr auto batch(std::span<key_type const> keys,
+                             std::span<value_type> values) const -> void {
+            for (auto i = std::size_t{}; i < keys.size(); ++i) {
+                values[i] = default_value;
+            }
+        }
     };
 
     template <typename Key, typename Value, typename Default, typename PextFunc,
@@ -299,6 +437,30 @@ struct pseudo_pext_lookup {
 
             return default_value;
         }
+
+        // extract, then load, compare and select one entry
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), 1, pext_func.instructions() + 3};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {PextFunc::name(), sizeof(*this), pext_func.mask, 1, 1};
+        }
+
+        // a vector kernel handles the bulk of the keys where one is
+        // available for the key and value types
+        constexpr auto batch(std::span<key_type const> keys,
+                             std::span<value_type> values) const -> void {
+            auto i = std::size_t{};
+            if (not std::is_constant_evaluated()) {
+                i = detail::vector_direct_batch(pext_func, storage, keys,
+                                                values, default_value);
+            }
+
+            for (; i < keys.size(); ++i) {
+                values[i] = (*this)[keys[i]];
+            }
+        }
     };
 
     // this is a workaround...
@@ -344,6 +506,20 @@ struct pseudo_pext_lookup {
 
             return default_value;
         }
+
+        // extract, load the index, then load and compare each entry of the
+        // longest bucket
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), search_len + 1,
+                    pext_func.instructions() + 1 + 3 * search_len};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {PextFunc::name(), sizeof(*this), pext_func.mask,
+                    search_len + 1,
+                    detail::average_bucket_probes(pext_func, lookup_table,
+                                                  storage)};
+        }
     };
 
   public:
@@ -358,63 +534,32 @@ struct pseudo_pext_lookup {
                       "Lookup keys must be unique.");
 
         constexpr auto mask_and_search =
-            detail::calc_pseudo_pext_mask(input.entries, MaxSearchLen);
+            detail::calc_pseudo_pext_mask<Extract>(input.entries, MaxSearchLen);
 
         constexpr auto mask = std::get<0>(mask_and_search);
         constexpr auto search_len = std::get<1>(mask_and_search) + 1;
 
         using search_len_t = smuggler<search_len>;
 
-        constexpr auto p = detail::pseudo_pext_t(mask);
-        constexpr auto lookup_table_size = 1 << std::popcount(mask);
+        constexpr auto p = Extract<raw_key_type>(mask);
+        constexpr auto table_bits =
+            std::min(std::popcount(mask), detail::max_pseudo_pext_bits);
+        constexpr auto lookup_table_size = 1 << table_bits;
 
         using default_value = default_value_smuggler<decltype(i)>;
 
         if constexpr (input.entries.empty()) {
             return empty_impl<key_type, value_type, default_value>{};
 
+        } else if constexpr (std::popcount(mask) >
+                             detail::max_pseudo_pext_bits) {
+            return strategy_failed_t{};
+
         } else if constexpr (use_indirect_strategy) {
             constexpr auto storage =
                 [&]() -> std::remove_const_t<decltype(input.entries)> {
                 auto s = input.entries;
-
-                // sort by the hashed key to group all the buckets together
-                std::sort(s.begin(), s.end(), [&](auto left, auto right) {
-                    return p(detail::as_raw_integral(left.key_)) <
-                           p(detail::as_raw_integral(right.key_));
-                });
-
-                // find end of the longest bucket
-                auto const end_of_longest_bucket = [&]() {
-                    auto e = s.begin();
-
-                    auto curr_bucket_length = 1u;
-                    auto prev_idx = p(detail::as_raw_integral(e->key_));
-                    e++;
-                    while (e != s.end()) {
-                        auto const curr_idx =
-                            p(detail::as_raw_integral(e->key_));
-
-                        if (curr_idx == prev_idx) {
-                            curr_bucket_length++;
-
-                        } else if (curr_bucket_length >= search_len) {
-                            return e;
-
-                        } else {
-                            curr_bucket_length = 1;
-                        }
-
-                        prev_idx = curr_idx;
-                        e++;
-                    }
-
-                    return e;
-                }();
-
-                // place the longest bucket at the end
-                std::rotate(s.begin(), end_of_longest_bucket, s.end());
-
+                detail::arrange_buckets(p, s, search_len);
                 return s;
             }();
 
@@ -424,20 +569,7 @@ struct pseudo_pext_lookup {
             constexpr auto lookup_table =
                 [&]() -> std::array<lookup_idx_t, lookup_table_size> {
                 std::array<lookup_idx_t, lookup_table_size> t{};
-
-                t.fill(0);
-
-                // iterate backwards so the index of the first entry of a bucket
-                // remains in the lookup table
-                for (auto entry_idx =
-                         static_cast<lookup_idx_t>(storage.size() - 1);
-                     entry_idx < storage.size(); entry_idx--) {
-                    auto const e = storage[entry_idx];
-                    auto const raw_key = detail::as_raw_integral(e.key_);
-                    auto const lookup_table_idx = p(raw_key);
-                    t[lookup_table_idx] = entry_idx;
-                }
-
+                detail::fill_lookup_table(p, t, storage);
                 return t;
             }();
 
@@ -0,0 +1,271 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+/// each level of the trie indexes its node by six bits of the key
+constexpr auto trie_chunk_bits = 6;
+
+/// a trie node has a bit for each of the 64 values of its chunk that some key
+/// has. a child that holds one key is an entry; otherwise it is another node.
+/// children are stored contiguously, so the index of a child is the base
+/// plus the number of bits set below its own. a node fills half a cache line
+struct alignas(32) trie_node {
+    std::uint64_t children{};
+    std::uint64_t leaves{};
+    std::uint32_t node_base{};
+    std::uint32_t entry_base{};
+};
+
+/// the shift of the chunk at each level. bits above the highest that differs
+/// between keys are the same for every key and are checked by the final
+/// comparison; the last level may overlap the one before it
+[[nodiscard]] constexpr auto trie_shift(int top, std::size_t level) -> int {
+    return std::max(
+        top - trie_chunk_bits * (static_cast<int>(level) + 1), 0);
+}
+
+template <typename Raw>
+[[nodiscard]] constexpr auto trie_chunk(Raw key, int shift) -> std::size_t {
+    return static_cast<std::size_t>(key >> shift) & 63u;
+}
+
+template <typename Raw, std::size_t S>
+[[nodiscard]] constexpr auto trie_top(std::array<Raw, S> const &keys) -> int {
+    if constexpr (S == 0) {
+        return 0;
+    } else {
+        auto diff = Raw{};
+        for (auto k : keys) {
+            diff = static_cast<Raw>(diff | (k ^ keys[0]));
+        }
+        return static_cast<int>(std::bit_width(diff));
+    }
+}
+
+struct trie_shape_t {
+    std::size_t nodes{};
+    std::size_t levels{};
+};
+
+/// the number of nodes under (and including) the node for the sorted keys in
+/// [lo, hi), and the number of levels down to its deepest entry
+template <typename Raw, std::size_t S>
+constexpr auto trie_shape(std::array<Raw, S> const &keys, std::size_t lo,
+                          std::size_t hi, int top, std::size_t level)
+    -> trie_shape_t {
+    auto shape = trie_shape_t{1, level + 1};
+    auto const shift = trie_shift(top, level);
+    while (lo != hi) {
+        auto const chunk = trie_chunk(keys[lo], shift);
+        auto end = lo + 1;
+        while (end != hi and trie_chunk(keys[end], shift) == chunk) {
+            ++end;
+        }
+        if (end - lo > 1) {
+            auto const child = trie_shape(keys, lo, end, top, level + 1);
+            shape.nodes += child.nodes;
+            shape.levels = std::max(shape.levels, child.levels);
+        }
+        lo = end;
+    }
+    return shape;
+}
+
+/// fill in the node for the sorted entries in [lo, hi): its single-key
+/// children go at the next free entries and its other children at the next
+/// free nodes, before any of them is filled in
+template <typename Nodes, typename Entries, typename Sorted>
+constexpr auto build_trie(Nodes &nodes, std::size_t &next_node,
+                          Entries &entries, std::size_t &next_entry,
+                          Sorted const &sorted, std::size_t node,
+                          std::size_t lo, std::size_t hi, int top,
+                          std::size_t level) -> void {
+    auto const shift = trie_shift(top, level);
+    auto const chunk_of = [&](std::size_t i) {
+        return trie_chunk(as_raw_integral(sorted[i].key_), shift);
+    };
+
+    auto &n = nodes[node];
+    n.node_base = static_cast<std::uint32_t>(next_node);
+    n.entry_base = static_cast<std::uint32_t>(next_entry);
+    for (auto i = lo; i != hi;) {
+        auto const chunk = chunk_of(i);
+        auto end = i + 1;
+        while (end != hi and chunk_of(end) == chunk) {
+            ++end;
+        }
+        n.children |= std::uint64_t{1} << chunk;
+        if (end - i == 1) {
+            n.leaves |= std::uint64_t{1} << chunk;
+            entries[next_entry++] = {as_raw_integral(sorted[i].key_),
+                                     sorted[i].value_};
+        } else {
+            ++next_node;
+        }
+        i = end;
+    }
+
+    auto child = std::size_t{n.node_base};
+    for (auto i = lo; i != hi;) {
+        auto const chunk = chunk_of(i);
+        auto end = i + 1;
+        while (end != hi and chunk_of(end) == chunk) {
+            ++end;
+        }
+        if (end - i > 1) {
+            build_trie(nodes, next_node, entries, next_entry, sorted, child++,
+                       i, end, top, level + 1);
+        }
+        i = end;
+    }
+}
+} // namespace detail
+
+/// a compressed radix trie (in the style of a hash array mapped trie) for
+/// large, sparse sets of keys that fit in 64 bits: each level indexes a node
+/// with six bits of the key and finds the child with a popcount, and a key
+/// that is alone in its subtree is stored in its parent. a lookup is at most
+/// MaxLevels dependent node loads and one entry load, and the trie takes
+/// little more space than the entries themselves. key sets that need more
+/// levels fail
+template <std::size_t MaxLevels = 11> struct radix_trie_lookup {
+  private:
+    template <typename Key, typename Value, std::size_t NumNodes,
+              std::size_t NumEntries, int Top, std::size_t Levels>
+    struct impl {
+        using key_type = Key;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+        using value_type = Value;
+
+        std::array<detail::trie_node, NumNodes> nodes;
+        std::array<entry<raw_key_type, value_type>, NumEntries> entries;
+        value_type default_value;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const raw_key = detail::as_raw_integral(key);
+            auto const *n = &nodes[0];
+            for (auto level = std::size_t{}; level < Levels; ++level) {
+                auto const shift = detail::trie_shift(Top, level);
+                auto const bit = std::uint64_t{1}
+                                 << detail::trie_chunk(raw_key, shift);
+                auto const below = bit - 1u;
+                if ((n->children & bit) == 0) {
+                    return default_value;
+                }
+                if ((n->leaves & bit) != 0) {
+                    auto const &e =
+                        entries[n->entry_base +
+                                static_cast<std::size_t>(
+                                    std::popcount(n->leaves & below))];
+                    return e.key_ == raw_key ? e.value_ : default_value;
+                }
+                n = &nodes[n->node_base +
+                           static_cast<std::size_t>(std::popcount(
+                               n->children & ~n->leaves & below))];
+            }
+            return default_value;
+        }
+
+        // each level shifts, masks, tests and counts to find the child; the
+        // entry is then loaded, compared and selected
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), Levels + 1, 8 * Levels + 3};
+        }
+
+        // the nodes down to each entry, then the entry itself
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            auto total = std::size_t{};
+            for (auto const &e : entries) {
+                auto const *n = &nodes[0];
+                for (auto level = std::size_t{}; level < Levels; ++level) {
+                    ++total;
+                    auto const bit =
+                        std::uint64_t{1}
+                        << detail::trie_chunk(e.key_,
+                                              detail::trie_shift(Top, level));
+                    if ((n->leaves & bit) != 0) {
+                        break;
+                    }
+                    n = &nodes[n->node_base +
+                               static_cast<std::size_t>(std::popcount(
+                                   n->children & ~n->leaves & (bit - 1u)))];
+                }
+            }
+            auto const average =
+                NumEntries == 0 ? 0.0
+                                : static_cast<double>(total + NumEntries) /
+                                      static_cast<double>(NumEntries);
+            return {"radix_trie", sizeof(*this), 0, Levels + 1, average};
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using input_t = std::remove_cv_t<decltype(input)>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+
+        if constexpr (not detail::packable_key<key_type>) {
+            return strategy_failed_t{};
+        } else {
+            using raw_key_type = detail::raw_integral_t<key_type>;
+
+            constexpr auto sorted = [&] {
+                auto s = input.entries;
+                std::sort(s.begin(), s.end(), [](auto const &l, auto const &r) {
+                    return detail::as_raw_integral(l.key_) <
+                           detail::as_raw_integral(r.key_);
+                });
+                return s;
+            }();
+            constexpr auto keys = [&] {
+                auto ks = std::array<raw_key_type, input_t::size>{};
+                std::transform(sorted.begin(), sorted.end(), ks.begin(),
+                               [](auto const &e) {
+                                   return detail::as_raw_integral(e.key_);
+                               });
+                return ks;
+            }();
+            static_assert(std::adjacent_find(keys.begin(), keys.end()) ==
+                              keys.end(),
+                          "Lookup keys must be unique.");
+
+            constexpr auto top = detail::trie_top(keys);
+            constexpr auto shape =
+                detail::trie_shape(keys, 0, input_t::size, top, 0);
+
+            if constexpr (shape.levels > MaxLevels) {
+                return strategy_failed_t{};
+            } else {
+                using impl_t = impl<key_type, value_type, shape.nodes,
+                                    input_t::size, top, shape.levels>;
+                constexpr auto table = [&] {
+                    auto t = impl_t{{}, {}, input.default_value};
+                    auto next_node = std::size_t{1};
+                    auto next_entry = std::size_t{};
+                    detail::build_trie(t.nodes, next_node, t.entries,
+                                       next_entry, sorted, 0, 0,
+                                       input_t::size, top, 0);
+                    return t;
+                }();
+                return table;
+            }
+        }
+    }
+};
+} // namespace lookup
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <lookup/arena.hpp>
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace lookup {
+/// the layout of pseudo_pext_lookup<true, MaxSearchLen>, built at runtime into
+/// arena memory. the storage is padded so that every search reads as many
+/// entries as the longest bucket the mask search can accept, so the search
+/// loop has a fixed length as it does in the compile-time table
+template <typename Key, typename Value, std::size_t MaxSearchLen>
+struct runtime_lookup {
+    constexpr static auto search_len =
+        MaxSearchLen > 1 ? MaxSearchLen + 1 : std::size_t{1};
+
+    using key_type = Key;
+    using raw_key_type = detail::raw_integral_t<key_type>;
+    using value_type = Value;
+    using index_type = std::uint32_t;
+    using storage_entry = entry<raw_key_type, value_type>;
+
+    detail::pseudo_pext_t<raw_key_type> pext_func;
+    value_type default_value;
+    std::span<index_type const> lookup_table;
+    std::span<storage_entry const> storage;
+
+    [[nodiscard]] auto operator[](key_type key) const -> value_type {
+        auto const raw_key = detail::as_raw_integral(key);
+        auto i = lookup_table[pext_func(raw_key)];
+
+        for (auto search_count = std::size_t{}; search_count < search_len;
+             search_count++) {
+            auto const e = storage[i];
+            if (raw_key == e.key_) {
+                return e.value_;
+            }
+
+            i++;
+        }
+
+        return default_value;
+    }
+
+    // extract, load the index, then load and compare each entry of the
+    // longest bucket
+    [[nodiscard]] auto cost() const -> cost_t {
+        return {sizeof(*this) + lookup_table.size_bytes() +
+                    storage.size_bytes(),
+                search_len + 1, pext_func.instructions() + 1 + 3 * search_len};
+    }
+
+    [[nodiscard]] auto info() const -> table_info {
+        return {"pseudo_pext_runtime", cost().bytes, pext_func.mask,
+                search_len + 1,
+                detail::average_bucket_probes(
+                    pext_func, lookup_table,
+                    storage.first(storage.size() - search_len))};
+    }
+};
+
+/// build a table from entries that are only known at runtime (e.g. loaded at
+/// startup), with the same mask search and layout as pseudo_pext_lookup. the
+/// table and the scratch space for the search come from the arena; nothing
+/// is allocated on the heap. if the arena is rewindable, the scratch space is
+/// given back, and so is everything else if the build fails.
+///
+/// returns std::nullopt if the keys are not unique, if they need a mask of
+/// more than max_pseudo_pext_bits bits, or if the arena is exhausted
+template <std::size_t MaxSearchLen = 2, std::ranges::contiguous_range Entries>
+[[nodiscard]] auto
+build_runtime(typename std::ranges::range_value_t<Entries>::value_type const
+                  &default_value,
+              Entries const &entries, arena auto &a)
+    -> std::optional<runtime_lookup<
+        typename std::ranges::range_value_t<Entries>::key_type,
+        typename std::ranges::range_value_t<Entries>::value_type,
+        MaxSearchLen>> {
+    static_assert(MaxSearchLen > 0);
+    using entry_t = std::ranges::range_value_t<Entries>;
+    using key_type = typename entry_t::key_type;
+    using value_type = typename entry_t::value_type;
+    static_assert(detail::packable_key<key_type>,
+                  "Composite lookup keys wider than 64 bits cannot be built "
+                  "at runtime.");
+    using table_t = runtime_lookup<key_type, value_type, MaxSearchLen>;
+    using raw_key_type = typename table_t::raw_key_type;
+    using index_type = typename table_t::index_type;
+
+    auto const n = std::ranges::size(entries);
+    constexpr auto padding = table_t::search_len;
+    if (n > std::numeric_limits<index_type>::max() - padding) {
+        return std::nullopt;
+    }
+
+    constexpr auto rewindable =
+        rewindable_arena<std::remove_cvref_t<decltype(a)>>;
+    auto start = std::size_t{};
+    if constexpr (rewindable) {
+        start = a.mark();
+    }
+    auto const fail = [&]() -> std::optional<table_t> {
+        if constexpr (rewindable) {
+            a.rewind(start);
+        }
+        return std::nullopt;
+    };
+
+    using storage_entry = typename table_t::storage_entry;
+    auto const storage =
+        detail::allocate_array<storage_entry>(a, n + padding);
+    if (storage.empty()) {
+        return fail();
+    }
+
+    // an empty table still needs a mask to extract with
+    auto mask = raw_key_type{1};
+    auto longest_bucket = std::size_t{1};
+    if (n != 0) {
+        auto m = std::size_t{};
+        if constexpr (rewindable) {
+            m = a.mark();
+        }
+
+        auto const keys = detail::allocate_array<raw_key_type>(a, n);
+        auto const slots =
+            detail::allocate_array<detail::multiplicity_slot<raw_key_type>>(
+                a, detail::multiplicity_capacity(n));
+        if (keys.empty() or slots.empty()) {
+            return fail();
+        }
+
+        std::ranges::transform(entries, keys.begin(), [](auto const &e) {
+            return detail::as_raw_integral(e.key_);
+        });
+        auto counter = detail::basic_multiplicity_counter<
+            raw_key_type, std::span<detail::multiplicity_slot<raw_key_type>>>{
+            slots};
+        counter.reset();
+        if (not std::ranges::all_of(keys, [&](raw_key_type k) {
+                return counter.insert(k) == 1;
+            })) {
+            return fail();
+        }
+
+        auto const mask_and_search = detail::calc_pseudo_pext_mask_for_keys(
+            std::span<raw_key_type const>{keys}, counter, MaxSearchLen);
+        mask = std::get<0>(mask_and_search);
+        longest_bucket = std::get<1>(mask_and_search) + 1;
+
+        if constexpr (rewindable) {
+            a.rewind(m);
+        }
+    }
+
+    auto const index_bits = static_cast<std::size_t>(std::popcount(mask));
+    if (index_bits >
+        static_cast<std::size_t>(detail::max_pseudo_pext_bits)) {
+        return fail();
+    }
+    auto const lookup_table =
+        detail::allocate_array<index_type>(a, std::size_t{1} << index_bits);
+    if (lookup_table.empty()) {
+        return fail();
+    }
+
+    // the padding after the longest bucket is read only by searches that
+    // have already passed every entry for their key: the default value at key
+    // 0 is correct whether or not key 0 is in the table
+    auto const p = detail::pseudo_pext_t<raw_key_type>{mask};
+    auto const used = storage.first(n);
+    std::ranges::transform(entries, used.begin(), [](auto const &e) {
+        return storage_entry{detail::as_raw_integral(e.key_), e.value_};
+    });
+    std::ranges::fill(storage.subspan(n),
+                      storage_entry{{}, default_value});
+    if (n != 0) {
+        detail::arrange_buckets(p, used, longest_bucket);
+    }
+    detail::fill_lookup_table(p, lookup_table, used);
+
+    return table_t{p, default_value, lookup_table, storage};
+}
+} // namespace lookup
@@ -0,0 +1,101 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/simd.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace lookup {
+template <std::size_t MaxSize> struct simd_linear_search_lookup {
+  private:
+    template <typename Key, typename Value, std::size_t N> struct impl {
+        using key_type = Key;
+        using value_type = Value;
+        using raw_key_type = detail::raw_integral_t<key_type>;
+
+        // keys are padded to a whole number of SIMD blocks by repeating the
+        // first key, which can never be found ahead of the first entry
+        constexpr static auto lanes = detail::simd_lanes<raw_key_type>;
+        constexpr static auto padded_size = (N + lanes - 1) / lanes * lanes;
+
+        // values[padded_size] is the default value, so that a failed search
+        // needs no branch
+        alignas(detail::simd_width)
+            std::array<raw_key_type, padded_size> keys{};
+        std::array<value_type, padded_size + 1> values{};
+
+        constexpr explicit impl(auto const &input) {
+            values.fill(input.default_value);
+            for (auto i = std::size_t{}; i < padded_size; ++i) {
+                keys[i] = detail::as_raw_integral(
+                    input.entries[i < N ? i : 0].key_);
+            }
+            for (auto i = std::size_t{}; i < N; ++i) {
+                values[i] = input.entries[i].value_;
+            }
+        }
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            return values[detail::find(keys, detail::as_raw_integral(key))];
+        }
+
+        // each block of keys is loaded, compared and tested, then the
+        // match is located and its value loaded
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            if constexpr (detail::has_simd_find) {
+                constexpr auto blocks = padded_size / lanes;
+                return {sizeof(*this), blocks + 1, 4 * blocks + 3};
+            } else {
+                return {sizeof(*this), padded_size + 1, 3 * padded_size + 1};
+            }
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            auto const probes = cost().probes;
+            return {"simd_linear_search", sizeof(*this), 0, probes,
+                    static_cast<double>(probes)};
+        }
+    };
+
+    template <typename Key, typename Value> struct empty_impl {
+        using key_type = Key;
+        using value_type = Value;
+
+        value_type default_value;
+
+        [[nodiscard]] constexpr auto operator[](key_type) const -> value_type {
+            return default_value;
+        }
+
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            return {sizeof(*this), 0, 1};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return {"simd_linear_search", sizeof(*this), 0, 0, 0};
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        constexpr auto input = i();
+        using input_t = std::remove_cv_t<decltype(input)>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+
+        if constexpr (input.size > MaxSize) {
+            return strategy_failed_t{};
+        } else if constexpr (input.size == 0) {
+            return empty_impl<key_type, value_type>{input.default_value};
+        } else {
+            return impl<key_type, value_type, input.size>{input};
+        }
+    }
+};
+} // namespace lookup
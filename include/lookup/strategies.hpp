@@ -1,5 +1,6 @@
 #pragma once
 
+#include <lookup/cost.hpp>
 #include <lookup/input.hpp>
 #include <lookup/strategy_failed.hpp>
 
@@ -7,7 +8,11 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
 
 namespace lookup {
 struct fail_strategy_t {
@@ -17,16 +22,81 @@ struct fail_strategy_t {
     }
 };
 
+namespace detail {
+template <typename Policy, typename T>
+constexpr auto score(T const &t) -> std::uint64_t {
+    if constexpr (std::is_same_v<T, strategy_failed_t>) {
+        return std::numeric_limits<std::uint64_t>::max();
+    } else {
+        return Policy::score(cost(t));
+    }
+}
+
+/// under first_success, the strategies after the first that succeeds would
+/// never be chosen, so they are not built
+template <typename T, typename... Ts>
+consteval auto make_first_success(compile_time auto input) {
+    constexpr auto table = T::make(input);
+    if constexpr (not strategy_failed(table)) {
+        return table;
+    } else if constexpr (sizeof...(Ts) == 0) {
+        return fail_strategy_t::make(input);
+    } else {
+        return make_first_success<Ts...>(input);
+    }
+}
+} // namespace detail
+
+/// strategies without a policy use the build-wide strategy_policy
 template <typename... Ts> struct strategies {
     [[nodiscard]] consteval static auto make(compile_time auto input) {
+        using policy_t =
+            typename decltype(detail::default_policy<decltype(input)>())::type;
+        return strategies<policy_t, Ts...>::make(input);
+    }
+};
+
+/// the successful strategy with the lowest score under the policy is chosen,
+/// and the first of equally-scored strategies
+template <selection_policy Policy, typename... Ts>
+struct strategies<Policy, Ts...> {
+    [[nodiscard]] consteval static auto make(compile_time auto input) {
+        if constexpr (std::is_same_v<Policy, first_success>) {
+            if constexpr (sizeof...(Ts) == 0) {
+                return fail_strategy_t::make(input);
+            } else {
+                return detail::make_first_success<Ts...>(input);
+            }
+        } else {
+            return make_best(input);
+        }
+    }
+
+  private:
+    [[nodiscard]] consteval static auto make_best(compile_time auto input) {
+        constexpr auto tables = std::tuple{Ts::make(input)...};
         constexpr auto idx = [&] {
-            constexpr auto results =
-                std::array{not strategy_failed(Ts::make(input))...};
-            return std::distance(
-                std::cbegin(results),
-                std::find(std::cbegin(results), std::cend(results), true));
+            constexpr auto scores = std::apply(
+                [](auto const &...ts) {
+                    return std::array<std::uint64_t, sizeof...(Ts) + 1>{
+                        detail::score<Policy>(ts)...,
+                        std::numeric_limits<std::uint64_t>::max()};
+                },
+                tables);
+            auto const best =
+                std::min_element(std::cbegin(scores), std::cend(scores));
+            if (*best == std::numeric_limits<std::uint64_t>::max()) {
+                return sizeof...(Ts);
+            }
+            return static_cast<std::size_t>(
+                std::distance(std::cbegin(scores), best));
         }();
-        return stdx::nth_t<idx, Ts..., fail_strategy_t>::make(input);
+
+        if constexpr (idx == sizeof...(Ts)) {
+            return fail_strategy_t::make(input);
+        } else {
+            return std::get<idx>(tables);
+        }
     }
 };
 } // namespace lookup
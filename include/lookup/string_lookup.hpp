@@ -0,0 +1,238 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <stdx/ct_string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace lookup {
+/// an entry keyed by a ct_string, for string_lookup
+template <stdx::ct_string Key, typename V>
+[[nodiscard]] constexpr auto string_entry(V const &v)
+    -> entry<std::string_view, V> {
+    return {std::string_view{Key}, v};
+}
+
+namespace detail {
+/// the most character positions that fit in a 64-bit digest with the length
+constexpr auto max_string_positions = std::size_t{7};
+
+/// a string's length and the characters at a few chosen positions, packed
+/// into an integer: strings that differ in those are certainly different
+constexpr auto string_digest(std::string_view s, std::uint8_t const *positions,
+                             std::size_t num_positions) -> std::uint64_t {
+    auto d = std::uint64_t{static_cast<std::uint8_t>(s.size())};
+    for (auto i = std::size_t{}; i < num_positions; ++i) {
+        auto const p = positions[i];
+        auto const c = p < s.size() ? static_cast<std::uint8_t>(s[p])
+                                    : std::uint8_t{};
+        d |= std::uint64_t{c} << (8 * (i + 1));
+    }
+    return d;
+}
+
+template <std::size_t K> struct string_digest_t {
+    std::array<std::uint8_t, K> positions{};
+
+    [[nodiscard]] constexpr auto operator()(std::string_view s) const
+        -> std::uint64_t {
+        return string_digest(s, positions.data(), K);
+    }
+};
+
+template <typename V, std::size_t S>
+constexpr auto
+string_keys_are_unique(std::array<entry<std::string_view, V>, S> const &es)
+    -> bool {
+    auto keys = std::array<std::string_view, S>{};
+    std::transform(es.begin(), es.end(), keys.begin(),
+                   [](auto const &e) { return e.key_; });
+    std::sort(keys.begin(), keys.end());
+    return std::adjacent_find(keys.begin(), keys.end()) == keys.end();
+}
+
+template <std::size_t S>
+constexpr auto count_distinct(std::array<std::uint64_t, S> const &digests)
+    -> std::size_t {
+    auto counter = multiplicity_counter<std::uint64_t, S>{};
+    counter.reset();
+    return static_cast<std::size_t>(
+        std::count_if(digests.begin(), digests.end(),
+                      [&](auto d) { return counter.insert(d) == 1; }));
+}
+
+/// character positions chosen greedily: each is the one that tells the most
+/// keys apart, given the length and the positions already chosen. the count
+/// is the number of positions that are needed, or more than
+/// max_string_positions if the keys cannot be told apart that way
+template <typename V, std::size_t S>
+constexpr auto
+choose_string_positions(std::array<entry<std::string_view, V>, S> const &es) {
+    auto positions = std::array<std::uint8_t, max_string_positions>{};
+    auto max_len = std::size_t{};
+    for (auto const &e : es) {
+        max_len = std::max(max_len, e.key_.size());
+    }
+    max_len = std::min(max_len, std::size_t{256});
+
+    auto digests = std::array<std::uint64_t, S>{};
+    auto const fill_digests = [&](std::size_t num_positions) {
+        for (auto i = std::size_t{}; i < S; ++i) {
+            digests[i] =
+                string_digest(es[i].key_, positions.data(), num_positions);
+        }
+    };
+
+    auto chosen = std::size_t{};
+    fill_digests(chosen);
+    auto distinct = count_distinct(digests);
+    while (distinct < S) {
+        if (chosen == max_string_positions) {
+            return std::pair{positions, max_string_positions + 1};
+        }
+
+        auto best = std::size_t{};
+        auto best_distinct = distinct;
+        for (auto p = std::size_t{}; p < max_len; ++p) {
+            positions[chosen] = static_cast<std::uint8_t>(p);
+            fill_digests(chosen + 1);
+            if (auto const n = count_distinct(digests); n > best_distinct) {
+                best = p;
+                best_distinct = n;
+            }
+        }
+        if (best_distinct == distinct) {
+            return std::pair{positions, max_string_positions + 1};
+        }
+        positions[chosen++] = static_cast<std::uint8_t>(best);
+        distinct = best_distinct;
+    }
+    return std::pair{positions, chosen};
+}
+} // namespace detail
+
+/// string keys (std::string_view) are looked up by their length and the
+/// characters at a few positions chosen at compile time to tell the keys
+/// apart. these are packed into a digest that Strategy maps to an entry, and
+/// one comparison of the whole string confirms the hit. keys that need more
+/// than seven positions to tell apart fail
+template <typename Strategy> struct string_lookup {
+  private:
+    template <typename I>
+    constexpr static auto positions =
+        detail::choose_string_positions(I{}().entries);
+
+    template <typename I>
+    constexpr static auto num_positions = positions<I>.second;
+
+    template <typename I>
+    constexpr static auto digest = [] {
+        auto d = detail::string_digest_t<num_positions<I>>{};
+        std::copy_n(positions<I>.first.begin(), num_positions<I>,
+                    d.positions.begin());
+        return d;
+    }();
+
+    template <typename I>
+    using index_t = detail::uint_for_<std::remove_cv_t<decltype(I{}())>::size>;
+
+    template <typename I>
+    using digest_key_t =
+        decltype(detail::uint_for_bits_f<8 * (num_positions<I> + 1)>());
+
+    template <typename I> struct digests_input {
+        using cx_value_t [[maybe_unused]] = void;
+
+        consteval auto operator()() const {
+            constexpr auto input = I{}();
+            using input_t = std::remove_cv_t<decltype(input)>;
+
+            auto entries =
+                std::array<entry<digest_key_t<I>, index_t<I>>, input_t::size>{};
+            for (auto i = std::size_t{}; i < input_t::size; ++i) {
+                entries[i] = {static_cast<digest_key_t<I>>(
+                                  digest<I>(input.entries[i].key_)),
+                              static_cast<index_t<I>>(i)};
+            }
+            return lookup::input{static_cast<index_t<I>>(input_t::size),
+                                 entries};
+        }
+    };
+
+    template <typename Value, typename Digest, typename Digests, std::size_t S>
+    struct impl {
+        using key_type = std::string_view;
+        using value_type = Value;
+        using digest_type = typename Digests::key_type;
+
+        Digest digest;
+        Digests digests;
+        // the last entry holds the default value
+        std::array<entry<std::string_view, value_type>, S + 1> storage;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            auto const &e =
+                storage[digests[static_cast<digest_type>(digest(key))]];
+            // a length check and a single memcmp
+            return e.key_ == key ? e.value_ : storage[S].value_;
+        }
+
+        // gather the digest, look it up, then compare the whole string
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            auto const c = lookup::cost(digests);
+            return {sizeof(*this), c.probes + 2,
+                    3 * digest.positions.size() + c.instructions + 4};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return lookup::info(digests).wrapped("string", sizeof(*this), 2);
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        using I = decltype(i);
+        using input_t = std::remove_cv_t<decltype(i())>;
+        using value_type = typename input_t::value_type;
+        static_assert(
+            std::is_same_v<typename input_t::key_type, std::string_view>,
+            "string_lookup needs std::string_view keys.");
+        static_assert(detail::string_keys_are_unique(i().entries),
+                      "Lookup keys must be unique.");
+
+        if constexpr (num_positions<I> > detail::max_string_positions) {
+            return strategy_failed_t{};
+        } else {
+            constexpr auto digests = Strategy::make(digests_input<I>{});
+            if constexpr (strategy_failed(digests)) {
+                return strategy_failed_t{};
+            } else {
+                constexpr auto input = i();
+                constexpr auto storage = [&] {
+                    auto s = std::array<entry<std::string_view, value_type>,
+                                        input_t::size + 1>{};
+                    std::copy(input.entries.begin(), input.entries.end(),
+                              s.begin());
+                    s[input_t::size].value_ = input.default_value;
+                    return s;
+                }();
+                return impl<value_type, std::remove_cv_t<decltype(digest<I>)>,
+                            std::remove_cv_t<decltype(digests)>,
+                            input_t::size>{digest<I>, digests, storage};
+            }
+        }
+    }
+};
+} // namespace lookup
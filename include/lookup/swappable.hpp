@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace lookup {
+/// a table whose contents can be replaced while other threads look keys up
+/// in it. a lookup is one acquire load of the current table followed by the
+/// table's own operator[]; there are no locks on the read side.
+///
+/// the table is double-buffered and reclaimed quiescent-state-style (QSBR):
+/// each reading thread registers a reader and calls quiescent() whenever it
+/// holds no reference into the table (e.g. between batches of packets).
+/// publish() fills the spare buffer, makes it current, and returns once every
+/// registered reader has been quiescent, after which nothing can still be
+/// reading the table that was replaced. only one thread may publish at a
+/// time, and it must not hold a reader itself
+template <typename Table, std::size_t MaxReaders = 16> class swappable {
+    static_assert(std::is_trivially_destructible_v<Table>,
+                  "Tables are overwritten in place when they are swapped.");
+
+    constexpr static auto unused = std::numeric_limits<std::uint64_t>::max();
+
+    std::array<Table, 2> tables;
+    std::atomic<Table const *> current{&tables[0]};
+    std::atomic<std::uint64_t> epoch{};
+    // the epoch that each reader last saw while quiescent
+    std::array<std::atomic<std::uint64_t>, MaxReaders> reader_epochs{};
+
+  public:
+    using key_type = typename Table::key_type;
+    using value_type = typename Table::value_type;
+
+    class reader {
+        friend class swappable;
+
+        swappable *s{};
+        std::size_t slot{};
+
+        reader(swappable *sw, std::size_t i) : s{sw}, slot{i} {}
+
+      public:
+        reader(reader &&other) noexcept
+            : s{std::exchange(other.s, nullptr)}, slot{other.slot} {}
+        reader(reader const &) = delete;
+        auto operator=(reader &&) -> reader & = delete;
+        auto operator=(reader const &) -> reader & = delete;
+
+        ~reader() {
+            if (s != nullptr) {
+                s->reader_epochs[slot].store(unused,
+                                             std::memory_order_release);
+            }
+        }
+
+        /// the thread holds no reference into the table
+        auto quiescent() const -> void {
+            s->reader_epochs[slot].store(
+                s->epoch.load(std::memory_order_acquire),
+                std::memory_order_release);
+        }
+    };
+
+    explicit swappable(Table const &initial) : tables{initial, initial} {
+        for (auto &e : reader_epochs) {
+            e.store(unused, std::memory_order_relaxed);
+        }
+    }
+
+    swappable(swappable const &) = delete;
+    auto operator=(swappable const &) -> swappable & = delete;
+
+    /// a reader for the calling thread, or std::nullopt if MaxReaders are
+    /// already registered
+    [[nodiscard]] auto register_reader() -> std::optional<reader> {
+        for (auto i = std::size_t{}; i < MaxReaders; ++i) {
+            // the slot is claimed with the oldest epoch before the current
+            // epoch is read. a publish whose scan misses the claim has
+            // already bumped the epoch, so the read below synchronizes with
+            // it and the reader's first snapshot sees the new table
+            auto expected = unused;
+            if (reader_epochs[i].compare_exchange_strong(
+                    expected, 0, std::memory_order_seq_cst)) {
+                reader_epochs[i].store(
+                    epoch.load(std::memory_order_seq_cst),
+                    std::memory_order_release);
+                return reader{this, i};
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// the current table; it stays valid until the reader is next quiescent
+    [[nodiscard]] auto snapshot() const -> Table const & {
+        return *current.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] auto operator[](key_type key) const -> value_type {
+        return snapshot()[key];
+    }
+
+    /// replace the table, returning once no reader can still see the old one
+    auto publish(Table const &t) -> void {
+        auto const *const old = current.load(std::memory_order_relaxed);
+        auto *const spare = old == &tables[0] ? &tables[1] : &tables[0];
+        *spare = t;
+        current.store(spare, std::memory_order_release);
+
+        auto const e = epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        for (auto const &r : reader_epochs) {
+            while (r.load(std::memory_order_seq_cst) < e) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// the number of times the table has been replaced
+    [[nodiscard]] auto version() const -> std::uint64_t {
+        return epoch.load(std::memory_order_acquire);
+    }
+};
+} // namespace lookup
@@ -0,0 +1,197 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lookup {
+namespace detail {
+/// the distinct values of one field of the keys, sorted; the count is the
+/// number of leading elements that are used
+template <std::size_t J, typename Input>
+constexpr auto key_field_values(Input const &input) {
+    using field_t = std::tuple_element_t<J, typename Input::key_type>;
+    auto values = std::array<field_t, Input::size>{};
+    std::transform(input.entries.begin(), input.entries.end(), values.begin(),
+                   [](auto const &e) { return std::get<J>(e.key_); });
+    std::sort(values.begin(), values.end(), [](auto lhs, auto rhs) {
+        return as_ordered_scalar(lhs) < as_ordered_scalar(rhs);
+    });
+    auto const last =
+        std::unique(values.begin(), values.end(), [](auto lhs, auto rhs) {
+            return as_ordered_scalar(lhs) == as_ordered_scalar(rhs);
+        });
+    return std::pair{values, static_cast<std::size_t>(
+                                 std::distance(values.begin(), last))};
+}
+} // namespace detail
+
+/// composite keys that are too wide to pack into one raw integral are looked
+/// up in two levels: first each field is mapped to a small id by its own
+/// table, then the packed ids are looked up to find the value. a field value
+/// that no key has maps to an id that no entry has, so a miss needs no branch
+template <typename Strategy> struct two_level_lookup {
+  private:
+    template <typename I>
+    using key_t = typename std::remove_cv_t<decltype(I{}())>::key_type;
+
+    template <typename I>
+    constexpr static auto num_fields = std::tuple_size_v<key_t<I>>;
+
+    template <typename I, std::size_t J>
+    constexpr static auto num_ids = detail::key_field_values<J>(I{}()).second;
+
+    template <typename I, std::size_t J>
+    using id_t = detail::uint_for_<num_ids<I, J>>;
+
+    template <typename I, typename Js> struct id_key;
+    template <typename I, std::size_t... Js>
+    struct id_key<I, std::index_sequence<Js...>> {
+        using type = std::tuple<id_t<I, Js>...>;
+    };
+
+    template <typename I>
+    using id_key_t =
+        typename id_key<I, std::make_index_sequence<num_fields<I>>>::type;
+
+    template <typename I, std::size_t J> struct field_input {
+        using cx_value_t [[maybe_unused]] = void;
+
+        consteval auto operator()() const {
+            using field_t = std::tuple_element_t<J, key_t<I>>;
+            constexpr auto n = num_ids<I, J>;
+
+            auto const values = detail::key_field_values<J>(I{}()).first;
+            auto entries = std::array<entry<field_t, id_t<I, J>>, n>{};
+            for (auto id = std::size_t{}; id < n; ++id) {
+                entries[id] = {values[id], static_cast<id_t<I, J>>(id)};
+            }
+            return lookup::input{static_cast<id_t<I, J>>(n), entries};
+        }
+    };
+
+    template <typename I> struct ids_input {
+        using cx_value_t [[maybe_unused]] = void;
+
+        template <std::size_t J>
+        constexpr static auto field_id(auto const &key) -> id_t<I, J> {
+            constexpr auto values = detail::key_field_values<J>(I{}()).first;
+            auto const it = std::lower_bound(
+                values.begin(), values.begin() + num_ids<I, J>,
+                std::get<J>(key), [](auto lhs, auto rhs) {
+                    return detail::as_ordered_scalar(lhs) <
+                           detail::as_ordered_scalar(rhs);
+                });
+            return static_cast<id_t<I, J>>(std::distance(values.begin(), it));
+        }
+
+        consteval auto operator()() const {
+            constexpr auto input = I{}();
+            using input_t = std::remove_cv_t<decltype(input)>;
+            using value_type = typename input_t::value_type;
+
+            auto entries =
+                std::array<entry<id_key_t<I>, value_type>, input_t::size>{};
+            std::transform(
+                input.entries.begin(), input.entries.end(), entries.begin(),
+                [](auto const &e) {
+                    return [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+                        return entry{id_key_t<I>{field_id<Js>(e.key_)...},
+                                     e.value_};
+                    }(std::make_index_sequence<num_fields<I>>{});
+                });
+            return lookup::input{input.default_value, entries};
+        }
+    };
+
+    template <typename Key, typename Value, typename Fields, typename Ids>
+    struct impl {
+        using key_type = Key;
+        using value_type = Value;
+
+        Fields fields;
+        Ids ids;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            return [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+                using id_key_type = std::tuple<typename std::tuple_element_t<
+                    Js, Fields>::value_type...>;
+                return ids[id_key_type{std::get<Js>(fields)[std::get<Js>(
+                    key)]...}];
+            }(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+        }
+
+        // every field is looked up, then the ids
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            auto c = lookup::cost(ids);
+            std::apply(
+                [&](auto const &...fs) {
+                    ((c.probes += lookup::cost(fs).probes,
+                      c.instructions += lookup::cost(fs).instructions),
+                     ...);
+                },
+                fields);
+            c.bytes = sizeof(*this);
+            return c;
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            auto t = lookup::info(ids).wrapped("two_level", sizeof(*this), 0);
+            std::apply(
+                [&](auto const &...fs) {
+                    ((t.max_probes += lookup::info(fs).max_probes,
+                      t.average_probes += lookup::info(fs).average_probes),
+                     ...);
+                },
+                fields);
+            return t;
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        using I = decltype(i);
+        using input_t = std::remove_cv_t<decltype(i())>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+        static_assert(detail::composite_key<key_type>,
+                      "two_level_lookup needs composite keys.");
+        static_assert(detail::packable_key<id_key_t<I>>,
+                      "Composite lookup key fields have too many distinct "
+                      "values for two_level_lookup.");
+
+        constexpr auto fields =
+            []<std::size_t... Js>(std::index_sequence<Js...>) {
+                return std::tuple{Strategy::make(field_input<I, Js>{})...};
+            }(std::make_index_sequence<num_fields<I>>{});
+        constexpr auto ids = Strategy::make(ids_input<I>{});
+
+        constexpr auto failed = std::apply(
+            [](auto const &...fs) {
+                return (std::is_same_v<std::remove_cvref_t<decltype(fs)>,
+                                       strategy_failed_t> or
+                        ...);
+            },
+            fields);
+        if constexpr (failed or strategy_failed(ids)) {
+            return strategy_failed_t{};
+        } else {
+            return impl<key_type, value_type,
+                        std::remove_cv_t<decltype(fields)>,
+                        std::remove_cv_t<decltype(ids)>>{fields, ids};
+        }
+    }
+};
+} // namespace lookup
@@ -0,0 +1,137 @@
+#pragma once
+#include <lookup/cost.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace lookup {
+namespace detail {
+template <typename V, std::size_t N> struct value_pool_t {
+    std::array<V, N + 1> values{};
+    std::size_t size{};
+
+    constexpr auto index_of(V const &v) const -> std::size_t {
+        for (auto i = std::size_t{}; i < size; ++i) {
+            if (values[i] == v) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    constexpr auto insert(V const &v) -> std::size_t {
+        auto const i = index_of(v);
+        if (i == size) {
+            values[size++] = v;
+        }
+        return i;
+    }
+};
+
+/// the distinct values of a table: the default value is first, followed by
+/// the entries' values in order of appearance
+template <typename Input>
+constexpr auto make_value_pool(Input const &input) {
+    auto pool = value_pool_t<typename Input::value_type, Input::size>{};
+    pool.insert(input.default_value);
+    for (auto const &e : input.entries) {
+        pool.insert(e.value_);
+    }
+    return pool;
+}
+} // namespace detail
+
+/// wide values that repeat are stored once in a pool, and the table built by
+/// Strategy holds narrow indices into it. a table whose values would not
+/// shrink this way fails
+template <typename Strategy> struct value_pool_lookup {
+  private:
+    template <typename I>
+    constexpr static auto pool = detail::make_value_pool(I{}());
+
+    template <typename I>
+    using index_t = detail::uint_for_<pool<I>.size - 1>;
+
+    template <typename I> struct indices_input {
+        using cx_value_t [[maybe_unused]] = void;
+
+        consteval auto operator()() const {
+            constexpr auto input = I{}();
+            using input_t = std::remove_cv_t<decltype(input)>;
+            using key_type = typename input_t::key_type;
+
+            auto entries =
+                std::array<entry<key_type, index_t<I>>, input_t::size>{};
+            for (auto i = std::size_t{}; i < input_t::size; ++i) {
+                entries[i] = {input.entries[i].key_,
+                              static_cast<index_t<I>>(pool<I>.index_of(
+                                  input.entries[i].value_))};
+            }
+            return lookup::input{index_t<I>{}, entries};
+        }
+    };
+
+    template <typename Key, typename Value, typename Table, std::size_t P>
+    struct impl {
+        using key_type = Key;
+        using value_type = Value;
+
+        Table table;
+        std::array<value_type, P> pool;
+
+        [[nodiscard]] constexpr auto operator[](key_type key) const
+            -> value_type {
+            return pool[table[key]];
+        }
+
+        // the index lookup, then a load from the pool
+        [[nodiscard]] constexpr auto cost() const -> cost_t {
+            auto const c = lookup::cost(table);
+            return {sizeof(*this), c.probes + 1, c.instructions + 1};
+        }
+
+        [[nodiscard]] constexpr auto info() const -> table_info {
+            return lookup::info(table).wrapped("value_pool", sizeof(*this), 1);
+        }
+    };
+
+  public:
+    [[nodiscard]] consteval static auto make(compile_time auto i) {
+        using I = decltype(i);
+        using input_t = std::remove_cv_t<decltype(i())>;
+        using key_type = typename input_t::key_type;
+        using value_type = typename input_t::value_type;
+
+        constexpr auto num_values = pool<I>.size;
+        constexpr auto pooled_bytes = num_values * sizeof(value_type) +
+                                      input_t::size * sizeof(index_t<I>);
+        constexpr auto unpooled_bytes = input_t::size * sizeof(value_type);
+
+        if constexpr (pooled_bytes >= unpooled_bytes) {
+            return strategy_failed_t{};
+        } else {
+            constexpr auto table = Strategy::make(indices_input<I>{});
+            if constexpr (strategy_failed(table)) {
+                return strategy_failed_t{};
+            } else {
+                constexpr auto values = [] {
+                    auto v = std::array<value_type, num_values>{};
+                    for (auto j = std::size_t{}; j < num_values; ++j) {
+                        v[j] = pool<I>.values[j];
+                    }
+                    return v;
+                }();
+                return impl<key_type, value_type,
+                            std::remove_cv_t<decltype(table)>, num_values>{
+                    table, values};
+            }
+        }
+    }
+};
+} // namespace lookup
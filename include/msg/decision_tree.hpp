@@ -0,0 +1,90 @@
+#pragma once
+
+#include <msg/detail/indexed_handler_common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace msg {
+namespace detail {
+/// a field value as an unsigned key that sorts in the same order
+template <std::integral T>
+[[nodiscard]] constexpr auto ordered_key(T t) -> std::uint64_t {
+    if constexpr (std::is_signed_v<T>) {
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(t)) ^
+               (std::uint64_t{1} << 63u);
+    } else {
+        return static_cast<std::uint64_t>(t);
+    }
+}
+} // namespace detail
+
+/// a node of a decision tree tests a field: its edges are the intervals of
+/// the field's values, in order, and the first interval starts at the
+/// smallest value. a leaf has no edges, and first is its candidates
+struct decision_node {
+    std::uint32_t field{};
+    std::uint32_t num_edges{};
+    std::uint32_t first{};
+};
+
+/// a decision tree over Fields: each message walks from the root down to a
+/// leaf, extracting one field at each node, and the leaf holds the callbacks
+/// that are still candidates. as for indices, the candidates may not match:
+/// their matchers are checked when they are called
+template <typename Value, std::size_t NumNodes, std::size_t NumEdges,
+          std::size_t NumLeaves, typename... Fields>
+struct decision_tree {
+    std::array<decision_node, NumNodes> nodes;
+    std::array<std::uint64_t, NumEdges> bounds;
+    std::array<std::uint32_t, NumEdges> targets;
+    std::array<Value, NumLeaves> leaves;
+
+    template <typename Msg>
+    constexpr static auto key(std::uint32_t field, Msg const &msg)
+        -> std::uint64_t {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            auto k = std::uint64_t{};
+            static_cast<void>(
+                ((field == Is and
+                  (k = detail::ordered_key(detail::field_key<Fields>(msg)),
+                   true)) or
+                 ...));
+            return k;
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    template <typename Msg>
+    constexpr auto operator()(Msg const &msg) const -> Value {
+        auto const *n = &nodes[0];
+        while (n->num_edges != 0) {
+            auto const k = key(n->field, msg);
+            // the first edge starts at the smallest value, so it is the
+            // fallback if the key is below every other bound
+            auto const b = std::next(bounds.begin(),
+                                     static_cast<std::ptrdiff_t>(n->first) + 1);
+            auto const e =
+                std::next(b, static_cast<std::ptrdiff_t>(n->num_edges) - 1);
+            auto const j = std::distance(b, std::upper_bound(b, e, k));
+            n = &nodes[targets[n->first + static_cast<std::size_t>(j)]];
+        }
+        return leaves[n->first];
+    }
+
+    // each message walks the tree on its own: the loads at each node depend
+    // on the key found at the one before
+    template <typename Msg, typename Candidates>
+    constexpr auto batch(std::span<Msg const> msgs,
+                         std::span<Candidates> candidates) const -> void {
+        std::transform(msgs.begin(), msgs.end(), candidates.begin(),
+                       [&](auto const &msg) { return (*this)(msg); });
+    }
+};
+} // namespace msg
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <match/and.hpp>
+#include <match/concepts.hpp>
+#include <match/not.hpp>
+#include <match/or.hpp>
+#include <msg/decision_tree.hpp>
+#include <msg/detail/indexed_builder_common.hpp>
+#include <msg/detail/indexed_handler_common.hpp>
+#include <msg/detail/separate_sum_terms.hpp>
+#include <msg/field_matchers.hpp>
+
+#include <stdx/bitset.hpp>
+#include <stdx/tuple.hpp>
+#include <stdx/tuple_algorithms.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace msg {
+namespace detail {
+template <typename M> struct matcher_fields {
+    using type = boost::mp11::mp_list<>;
+};
+
+template <match::matcher L, match::matcher R>
+struct matcher_fields<match::and_t<L, R>> {
+    using type = boost::mp11::mp_append<typename matcher_fields<L>::type,
+                                        typename matcher_fields<R>::type>;
+};
+
+template <match::matcher L, match::matcher R>
+struct matcher_fields<match::or_t<L, R>> {
+    using type = boost::mp11::mp_append<typename matcher_fields<L>::type,
+                                        typename matcher_fields<R>::type>;
+};
+
+template <match::matcher M> struct matcher_fields<match::not_t<M>> {
+    using type = typename matcher_fields<M>::type;
+};
+
+template <typename RelOp, typename Field, auto X>
+struct matcher_fields<rel_matcher_t<RelOp, Field, X>> {
+    using type = boost::mp11::mp_list<Field>;
+};
+
+template <typename Field>
+using is_tree_field =
+    std::bool_constant<range_indexable<typename Field::value_type>>;
+
+/// the fields that a decision tree can test: those of integral type that the
+/// callbacks' matchers compare with constants
+template <typename Callbacks> struct tree_fields;
+
+template <typename... Callbacks> struct tree_fields<stdx::tuple<Callbacks...>> {
+    using type = boost::mp11::mp_copy_if<
+        boost::mp11::mp_unique<boost::mp11::mp_append<
+            boost::mp11::mp_list<>,
+            typename matcher_fields<typename Callbacks::matcher_t>::type...>>,
+        is_tree_field>;
+};
+
+template <typename Callbacks>
+using tree_fields_t = typename tree_fields<Callbacks>::type;
+} // namespace detail
+
+template <typename Callbacks, typename MsgBase, typename... ExtraCallbackArgs>
+struct decision_tree_builder {
+    Callbacks callbacks;
+
+    template <typename... Ts> [[nodiscard]] constexpr auto add(Ts... ts) {
+        auto new_callbacks =
+            stdx::tuple_cat(callbacks, separate_sum_terms(ts)...);
+        using new_callbacks_t = decltype(new_callbacks);
+        return decision_tree_builder<new_callbacks_t, MsgBase,
+                                     ExtraCallbackArgs...>{new_callbacks};
+    }
+
+  private:
+    using fields_t = detail::tree_fields_t<Callbacks>;
+    constexpr static auto num_fields = boost::mp11::mp_size<fields_t>::value;
+    static_assert(num_fields <= 64,
+                  "A decision tree can test at most 64 different fields.");
+
+    constexpr static auto num_callbacks = stdx::tuple_size_v<Callbacks>;
+    using value_t =
+        stdx::bitset<std::max(num_callbacks, std::size_t{1}), std::uint64_t>;
+
+    constexpr static auto all_callbacks() -> value_t {
+        auto v = value_t{};
+        for (auto i = std::size_t{}; i < num_callbacks; ++i) {
+            v.set(i);
+        }
+        return v;
+    }
+
+    constexpr static auto walk_rel_terms(auto const &cbs, auto const &f)
+        -> void {
+        auto idx = std::size_t{};
+        stdx::for_each(
+            [&](auto const &callback) {
+                index_rel_terms(callback.matcher, f, idx++);
+            },
+            cbs);
+    }
+
+    // the values of Field split where any term on it changes, with the
+    // callbacks whose terms on it hold in each interval
+    template <typename BuilderValue, typename Field>
+    constexpr static auto field_segments = [] {
+        constexpr auto capacity = [] {
+            auto n = std::size_t{};
+            walk_rel_terms(BuilderValue::value.callbacks,
+                           [&]<typename F>(std::size_t, rel_op, auto) {
+                               if constexpr (std::is_same_v<F, Field>) {
+                                   ++n;
+                               }
+                           });
+            return std::max(n, std::size_t{1});
+        }();
+        auto field_index =
+            temp_index<Field, capacity,
+                       std::max(num_callbacks, std::size_t{1})>{};
+        walk_rel_terms(
+            BuilderValue::value.callbacks,
+            [&]<typename F>(std::size_t idx, rel_op op, auto value) {
+                if constexpr (std::is_same_v<F, Field>) {
+                    field_index.add_rel_term(value, idx, op);
+                }
+            });
+        return field_index.segments(num_callbacks);
+    }();
+
+    struct segment {
+        std::uint64_t lo{};
+        value_t value{};
+    };
+
+    template <std::size_t NumSegments> struct segment_table {
+        std::array<segment, NumSegments> entries{};
+        std::array<std::size_t, num_fields + 1> offsets{};
+    };
+
+    // the segments of every field, one after another
+    template <typename BuilderValue>
+    constexpr static auto segments =
+        []<typename... Fields>(boost::mp11::mp_list<Fields...>) {
+            constexpr auto total =
+                (std::size_t{} + ... +
+                 field_segments<BuilderValue, Fields>.size);
+            auto t = segment_table<total>{};
+            auto n = std::size_t{};
+            auto f = std::size_t{};
+            [[maybe_unused]] auto const append = [&](auto const &segs) {
+                t.offsets[f++] = n;
+                for (auto i = std::size_t{}; i < segs.size; ++i) {
+                    t.entries[n++] = {detail::ordered_key(segs.entries[i].lo),
+                                      segs.entries[i].value};
+                }
+            };
+            (append(field_segments<BuilderValue, Fields>), ...);
+            t.offsets[f] = n;
+            return t;
+        }(fields_t{});
+
+    // the candidates left by each interval of a field, with adjacent
+    // intervals that leave the same candidates merged
+    constexpr static auto for_each_branch(auto const &table, std::size_t field,
+                                          value_t const &candidates,
+                                          auto const &f) -> void {
+        auto prev = value_t{};
+        for (auto i = table.offsets[field]; i < table.offsets[field + 1];
+             ++i) {
+            auto const c = candidates & table.entries[i].value;
+            if (i == table.offsets[field] or c != prev) {
+                f(table.entries[i].lo, c);
+                prev = c;
+            }
+        }
+    }
+
+    struct split_t {
+        std::size_t field{};
+        std::size_t branches{};
+        std::size_t total{};
+    };
+
+    // the untested field whose branches leave the fewest candidates on
+    // average (or fewest branches, if that is equal); the field is num_fields
+    // if there is no need to split because no field narrows the candidates
+    // or there is at most one
+    constexpr static auto choose_split(auto const &table,
+                                       value_t const &candidates,
+                                       std::uint64_t tested) -> split_t {
+        auto best = split_t{num_fields};
+        if (candidates.count() <= 1) {
+            return best;
+        }
+        for (auto field = std::size_t{}; field < num_fields; ++field) {
+            if (((tested >> field) & 1u) != 0) {
+                continue;
+            }
+            auto s = split_t{field};
+            auto narrows = false;
+            for_each_branch(table, field, candidates,
+                            [&](auto, value_t const &c) {
+                                ++s.branches;
+                                s.total += c.count();
+                                narrows = narrows or c != candidates;
+                            });
+            if (not narrows) {
+                continue;
+            }
+            auto const lhs = s.total * best.branches;
+            auto const rhs = best.total * s.branches;
+            if (best.field == num_fields or lhs < rhs or
+                (lhs == rhs and s.branches < best.branches)) {
+                best = s;
+            }
+        }
+        return best;
+    }
+
+    // a bound on the size of the tree, and so on the time taken to build it
+    constexpr static auto max_tree_nodes = std::size_t{1024};
+
+    // the split at each node of the tree, in preorder; a leaf's field is
+    // num_fields. planning stops once max_tree_nodes have been used
+    struct plan_t {
+        std::array<split_t, max_tree_nodes> splits{};
+        std::size_t num_nodes{};
+        std::size_t num_edges{};
+        bool fits{true};
+    };
+
+    constexpr static auto plan_tree(plan_t &plan, auto const &table,
+                                    value_t const &candidates,
+                                    std::uint64_t tested, std::size_t depth)
+        -> void {
+        if (plan.num_nodes == max_tree_nodes) {
+            plan.fits = false;
+            return;
+        }
+        auto const split = depth == 0
+                               ? split_t{num_fields}
+                               : choose_split(table, candidates, tested);
+        plan.splits[plan.num_nodes++] = split;
+        if (split.field == num_fields) {
+            return;
+        }
+        plan.num_edges += split.branches;
+        for_each_branch(
+            table, split.field, candidates, [&](auto, value_t const &c) {
+                if (plan.fits) {
+                    plan_tree(plan, table, c,
+                              tested | (std::uint64_t{1} << split.field),
+                              depth - 1);
+                }
+            });
+    }
+
+    // the deepest tree that fits in max_tree_nodes. a shallower tree leaves
+    // more candidates at its leaves, but they still check their matchers
+    template <typename BuilderValue>
+    constexpr static auto tree_plan = [] {
+        auto depth = num_fields;
+        while (true) {
+            auto plan = plan_t{};
+            plan_tree(plan, segments<BuilderValue>, all_callbacks(), 0, depth);
+            if (plan.fits or depth == 0) {
+                return plan;
+            }
+            --depth;
+        }
+    }();
+
+    template <std::size_t MaxNodes, std::size_t MaxEdges> struct temp_tree {
+        std::array<decision_node, MaxNodes> nodes{};
+        std::array<std::uint64_t, MaxEdges> bounds{};
+        std::array<std::uint32_t, MaxEdges> targets{};
+        std::array<value_t, MaxNodes> leaves{};
+        std::array<std::uint32_t, MaxNodes> leaf_nodes{};
+        std::size_t num_nodes{};
+        std::size_t num_edges{};
+        std::size_t num_leaves{};
+    };
+
+    // the tree follows the plan, so no split is chosen twice. a node's edges
+    // are allocated before its children, so they are contiguous; leaves with
+    // the same candidates are shared
+    constexpr static auto build_tree(auto &tree, plan_t const &plan,
+                                     std::size_t &next, auto const &table,
+                                     value_t const &candidates)
+        -> std::uint32_t {
+        auto const split = plan.splits[next++];
+        if (split.field == num_fields) {
+            for (auto i = std::size_t{}; i < tree.num_leaves; ++i) {
+                if (tree.leaves[i] == candidates) {
+                    return tree.leaf_nodes[i];
+                }
+            }
+            auto const node = static_cast<std::uint32_t>(tree.num_nodes++);
+            tree.nodes[node] = {0, 0,
+                                static_cast<std::uint32_t>(tree.num_leaves)};
+            tree.leaves[tree.num_leaves] = candidates;
+            tree.leaf_nodes[tree.num_leaves++] = node;
+            return node;
+        }
+
+        auto const node = tree.num_nodes++;
+        auto edge = tree.num_edges;
+        tree.nodes[node] = {static_cast<std::uint32_t>(split.field),
+                            static_cast<std::uint32_t>(split.branches),
+                            static_cast<std::uint32_t>(edge)};
+        tree.num_edges += split.branches;
+        for_each_branch(table, split.field, candidates,
+                        [&](std::uint64_t lo, value_t const &c) {
+                            auto const target =
+                                build_tree(tree, plan, next, table, c);
+                            tree.bounds[edge] = lo;
+                            tree.targets[edge++] = target;
+                        });
+        return static_cast<std::uint32_t>(node);
+    }
+
+    template <typename BuilderValue>
+    constexpr static auto built_tree = [] {
+        constexpr auto const &plan = tree_plan<BuilderValue>;
+        auto t = temp_tree<plan.num_nodes, plan.num_edges>{};
+        auto next = std::size_t{};
+        build_tree(t, plan, next, segments<BuilderValue>, all_callbacks());
+        return t;
+    }();
+
+    using callback_func_t = auto (*)(MsgBase const &, ExtraCallbackArgs... args)
+        -> bool;
+
+    // the tree only narrows the candidates, so each callback checks its
+    // whole matcher
+    template <typename BuilderValue, typename Nexus, std::size_t I>
+    constexpr static auto invoke_callback(MsgBase const &data,
+                                          ExtraCallbackArgs... args) -> bool {
+        constexpr auto cb = BuilderValue::value.callbacks[stdx::index<I>];
+        return cb.template handle<Nexus>(data, args...);
+    }
+
+    template <typename BuilderValue, typename Nexus, std::size_t... Is>
+    static consteval auto create_callback_array(std::index_sequence<Is...>)
+        -> std::array<callback_func_t, num_callbacks> {
+        return {invoke_callback<BuilderValue, Nexus, Is>...};
+    }
+
+  public:
+    template <typename BuilderValue, typename Nexus>
+    static consteval auto build() {
+        constexpr auto baked_tree =
+            []<typename... Fields>(boost::mp11::mp_list<Fields...>) {
+                constexpr auto const &t = built_tree<BuilderValue>;
+                auto d = decision_tree<value_t, t.num_nodes, t.num_edges,
+                                       t.num_leaves, Fields...>{};
+                std::copy_n(t.nodes.begin(), t.num_nodes, d.nodes.begin());
+                std::copy_n(t.bounds.begin(), t.num_edges, d.bounds.begin());
+                std::copy_n(t.targets.begin(), t.num_edges,
+                            d.targets.begin());
+                std::copy_n(t.leaves.begin(), t.num_leaves, d.leaves.begin());
+                return d;
+            }(fields_t{});
+
+        constexpr auto callback_array =
+            create_callback_array<BuilderValue, Nexus>(
+                std::make_index_sequence<num_callbacks>{});
+
+        return make_indexed_handler<MsgBase, ExtraCallbackArgs...>(
+            baked_tree, callback_array);
+    }
+};
+} // namespace msg
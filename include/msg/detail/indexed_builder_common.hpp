@@ -25,6 +25,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -67,11 +68,24 @@ struct temp_index {
     using field_type = FieldType;
     using key_type = typename field_type::value_type;
 
-    using value_t = stdx::bitset<CallbackCapacity, std::uint32_t>;
+    // 64-bit words halve the word operations when candidates are intersected
+    // and iterated
+    using value_t = stdx::bitset<CallbackCapacity, std::uint64_t>;
     stdx::cx_map<key_type, value_t, EntryCapacity> entries{};
     value_t default_value{};
     value_t negative_value{};
 
+    // every relation on the field, for indexing by intervals when some of
+    // them are ranges
+    struct rel_term {
+        std::size_t idx{};
+        rel_op op{};
+        key_type value{};
+    };
+    std::array<rel_term, EntryCapacity> rel_terms{};
+    std::size_t num_rel_terms{};
+    bool has_range_terms{};
+
     constexpr auto add_positive(key_type key, std::size_t idx) -> void {
         // add this index into the map: simple
         if (not entries.contains(key)) {
@@ -110,6 +124,131 @@ struct temp_index {
         negative_value.set(idx);
     }
 
+    constexpr auto add_rel_term(key_type key, std::size_t idx, rel_op op)
+        -> void {
+        rel_terms[num_rel_terms++] = {idx, op, key};
+        if constexpr (detail::range_indexable<key_type>) {
+            has_range_terms = has_range_terms or op == rel_op::less or
+                              op == rel_op::less_equal or
+                              op == rel_op::greater or
+                              op == rel_op::greater_equal;
+        }
+    }
+
+    /// the callbacks whose terms on the field all hold for key
+    [[nodiscard]] constexpr auto candidates_at(key_type key,
+                                               std::size_t num_callbacks) const
+        -> value_t {
+        auto v = value_t{};
+        for (auto idx = std::size_t{}; idx < num_callbacks; ++idx) {
+            v.set(idx);
+        }
+        for (auto i = std::size_t{}; i < num_rel_terms; ++i) {
+            auto const &t = rel_terms[i];
+            auto const holds = [&] {
+                switch (t.op) {
+                case rel_op::less:
+                    return key < t.value;
+                case rel_op::less_equal:
+                    return key <= t.value;
+                case rel_op::greater:
+                    return key > t.value;
+                case rel_op::greater_equal:
+                    return key >= t.value;
+                case rel_op::equal:
+                    return key == t.value;
+                default:
+                    return key != t.value;
+                }
+            }();
+            if (not holds) {
+                v.reset(t.idx);
+            }
+        }
+        return v;
+    }
+
+    struct segment {
+        key_type lo{};
+        value_t value{};
+    };
+    struct segments_t {
+        std::array<segment, 2 * EntryCapacity + 1> entries{};
+        std::size_t size{};
+    };
+
+    /// the field's domain split wherever a term changes from true to false,
+    /// with adjacent segments that have the same candidates merged: each
+    /// segment runs from its lo up to the next segment's lo, and the last one
+    /// to the largest key
+    [[nodiscard]] constexpr auto segments(std::size_t num_callbacks) const
+        -> segments_t {
+        using limits = std::numeric_limits<key_type>;
+        auto bounds = std::array<key_type, 2 * EntryCapacity + 1>{};
+        auto n = std::size_t{};
+        bounds[n++] = limits::min();
+        auto const add_bound = [&](key_type b, bool after) {
+            if (not after) {
+                bounds[n++] = b;
+            } else if (b != limits::max()) {
+                bounds[n++] = static_cast<key_type>(b + 1);
+            }
+        };
+        for (auto i = std::size_t{}; i < num_rel_terms; ++i) {
+            auto const &t = rel_terms[i];
+            auto const before = t.op == rel_op::less or
+                                t.op == rel_op::greater_equal or
+                                t.op == rel_op::equal or
+                                t.op == rel_op::not_equal;
+            auto const after = t.op != rel_op::less and
+                               t.op != rel_op::greater_equal;
+            if (before) {
+                add_bound(t.value, false);
+            }
+            if (after) {
+                add_bound(t.value, true);
+            }
+        }
+        auto const end = std::next(bounds.begin(),
+                                   static_cast<std::ptrdiff_t>(n));
+        std::sort(bounds.begin(), end);
+        n = static_cast<std::size_t>(
+            std::distance(bounds.begin(), std::unique(bounds.begin(), end)));
+
+        auto segs = segments_t{};
+        for (auto i = std::size_t{}; i < n; ++i) {
+            auto const v = candidates_at(bounds[i], num_callbacks);
+            if (segs.size == 0 or segs.entries[segs.size - 1].value != v) {
+                segs.entries[segs.size++] = {bounds[i], v};
+            }
+        }
+        return segs;
+    }
+
+    /// the number of callbacks that a lookup leaves as candidates, averaged
+    /// over the keys (or segments) and the default; the fewer, the more
+    /// selective the index
+    [[nodiscard]] constexpr auto
+    mean_candidates(std::size_t num_callbacks) const -> double {
+        if constexpr (detail::range_indexable<key_type>) {
+            if (has_range_terms) {
+                auto const segs = segments(num_callbacks);
+                auto total = std::size_t{};
+                for (auto i = std::size_t{}; i < segs.size; ++i) {
+                    total += segs.entries[i].value.count();
+                }
+                return static_cast<double>(total) /
+                       static_cast<double>(segs.size);
+            }
+        }
+        auto total = default_value.count();
+        for (auto const &entry : entries) {
+            total += entry.value.count();
+        }
+        return static_cast<double>(total) /
+               static_cast<double>(entries.size() + 1);
+    }
+
     constexpr auto propagate_positive_defaults() -> void {
         // the "positive defaults" are the defaults without the negatives
         auto const def = default_value & ~negative_value;
@@ -120,11 +259,17 @@ struct temp_index {
     }
 };
 
+/// a field named in an index_spec; the builder sizes its temp_index from the
+/// callbacks once they are known
+template <typename FieldType> struct index_field {
+    using field_type = FieldType;
+};
+
 template <typename T> using get_field_type = typename T::field_type;
 
 template <typename... Fields>
 using index_spec = decltype(stdx::make_indexed_tuple<get_field_type>(
-    temp_index<Fields, 512, 256>{}...));
+    index_field<Fields>{}...));
 
 template <template <typename, typename, typename, typename...> typename Parent,
           typename IndexSpec, typename Callbacks, typename MsgBase,
@@ -178,12 +323,41 @@ struct indexed_builder_base {
                        callbacks);
     }
 
+    // an upper bound on the number of keys in the index for Field: one per
+    // relation on the field
+    template <typename BuilderValue, typename Field>
+    static consteval auto entry_capacity() -> std::size_t {
+        auto n = std::size_t{};
+        auto const count = [&]<typename F>(std::size_t, auto) {
+            if constexpr (std::is_same_v<F, Field>) {
+                ++n;
+            }
+        };
+        walk_matcher(index_rel_terms, BuilderValue::value.callbacks, count);
+        return std::max(n, std::size_t{1});
+    }
+
+    // each index has room for exactly the keys and callbacks that it needs
+    template <typename BuilderValue>
+    static consteval auto create_empty_temp_indices() {
+        constexpr auto num_callbacks =
+            std::max(BuilderValue::value.callbacks.size(), std::size_t{1});
+        return IndexSpec{}.apply([]<typename... Is>(Is...) {
+            return stdx::make_indexed_tuple<get_field_type>(
+                temp_index<typename Is::field_type,
+                           entry_capacity<BuilderValue,
+                                          typename Is::field_type>(),
+                           num_callbacks>{}...);
+        });
+    }
+
     template <typename BuilderValue>
     static consteval auto create_temp_indices() {
-        IndexSpec indices{};
+        auto indices = create_empty_temp_indices<BuilderValue>();
+        using indices_t = decltype(indices);
         walk_matcher(index_terms, BuilderValue::value.callbacks,
                      [&]<typename Field>(std::size_t idx, auto expected_value) {
-                         if constexpr (stdx::contains_type<IndexSpec, Field>) {
+                         if constexpr (stdx::contains_type<indices_t, Field>) {
                              get<Field>(indices).add_positive(expected_value,
                                                               idx);
                          }
@@ -194,14 +368,31 @@ struct indexed_builder_base {
                        indices);
         walk_matcher(index_not_terms, BuilderValue::value.callbacks,
                      [&]<typename Field>(std::size_t idx, auto expected_value) {
-                         if constexpr (stdx::contains_type<IndexSpec, Field>) {
+                         if constexpr (stdx::contains_type<indices_t, Field>) {
                              get<Field>(indices).add_negative(expected_value,
                                                               idx);
                          }
                      });
         stdx::for_each([](auto &index) { index.propagate_positive_defaults(); },
                        indices);
+        walk_matcher(
+            index_rel_terms, BuilderValue::value.callbacks,
+            [&]<typename Field>(std::size_t idx, rel_op op, auto value) {
+                if constexpr (stdx::contains_type<indices_t, Field>) {
+                    get<Field>(indices).add_rel_term(value, idx, op);
+                }
+            });
         return indices;
     }
+
+    // consteval calls are not memoized, so the temp indices are built once
+    // here and everything that needs them reads them from here
+    template <typename BuilderValue>
+    constexpr static auto temp_indices =
+        create_temp_indices<BuilderValue>();
+
+    template <typename BuilderValue>
+    using temp_indices_t =
+        std::remove_cvref_t<decltype(temp_indices<BuilderValue>)>;
 };
 } // namespace msg
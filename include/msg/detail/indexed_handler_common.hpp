@@ -1,18 +1,36 @@
 #pragma once
 
 #include <log/log.hpp>
+#include <lookup/batch.hpp>
 #include <msg/handler_interface.hpp>
 #include <msg/message.hpp>
 
 #include <stdx/ranges.hpp>
 #include <stdx/utility.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <span>
 #include <type_traits>
 #include <utility>
 
 namespace msg {
+namespace detail {
+/// handle_batch looks up the indices for this many messages at a time
+constexpr inline auto batch_chunk_size = std::size_t{32};
+
+template <typename Field, typename Msg>
+constexpr auto field_key(Msg const &msg) {
+    if constexpr (stdx::range<Msg>) {
+        return Field::extract(msg);
+    } else {
+        return Field::extract(std::data(msg));
+    }
+}
+} // namespace detail
 
 template <typename Field, typename Lookup> struct index {
     Lookup field_lookup;
@@ -20,12 +38,27 @@ template <typename Field, typename Lookup> struct index {
     consteval index(Field, Lookup field_lookup_arg)
         : field_lookup{field_lookup_arg} {}
 
+    template <typename Msg> constexpr static auto key(Msg const &msg) {
+        return detail::field_key<Field>(msg);
+    }
+
     template <typename Msg> constexpr auto operator()(Msg const &msg) const {
-        if constexpr (stdx::range<Msg>) {
-            return field_lookup[Field::extract(msg)];
-        } else {
-            return field_lookup[Field::extract(std::data(msg))];
+        return field_lookup[key(msg)];
+    }
+
+    // the keys for a chunk of messages are extracted first and looked up
+    // together, so that the table loads for different messages overlap
+    template <typename Msg>
+    constexpr auto batch(std::span<Msg const> msgs,
+                         std::span<typename Lookup::value_type> results) const
+        -> void {
+        auto keys =
+            std::array<typename Lookup::key_type, detail::batch_chunk_size>{};
+        for (auto i = std::size_t{}; i < msgs.size(); ++i) {
+            keys[i] = key(msgs[i]);
         }
+        lookup::batch(field_lookup, std::span{keys}.first(msgs.size()),
+                      results);
     }
 };
 
@@ -49,8 +82,33 @@ struct indexed_handler : handler_interface<MsgBase, ExtraCallbackArgs...> {
     __attribute__((flatten)) auto handle(MsgBase const &msg,
                                          ExtraCallbackArgs... args) const
         -> bool final {
-        auto const callback_candidates = index(msg);
+        return dispatch(msg, index(msg), args...);
+    }
+
+    // the index lookups for a whole chunk of messages are done before any of
+    // their callbacks run
+    __attribute__((flatten)) auto handle_batch(std::span<MsgBase const> msgs,
+                                               ExtraCallbackArgs... args) const
+        -> std::size_t final {
+        using candidates_t = decltype(index(std::declval<MsgBase const &>()));
+        auto candidates = std::array<candidates_t, detail::batch_chunk_size>{};
+
+        auto handled = std::size_t{};
+        while (not msgs.empty()) {
+            auto const chunk =
+                msgs.first(std::min(msgs.size(), detail::batch_chunk_size));
+            index.batch(chunk, std::span{candidates}.first(chunk.size()));
+            for (auto i = std::size_t{}; i < chunk.size(); ++i) {
+                handled += dispatch(chunk[i], candidates[i], args...) ? 1u : 0u;
+            }
+            msgs = msgs.subspan(chunk.size());
+        }
+        return handled;
+    }
 
+  private:
+    auto dispatch(MsgBase const &msg, auto const &callback_candidates,
+                  ExtraCallbackArgs... args) const -> bool {
         bool const handled = transform_reduce(
             [&](auto i) -> bool { return callback_entries[i](msg, args...); },
             std::logical_or{}, false, callback_candidates);
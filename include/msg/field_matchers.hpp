@@ -67,6 +67,41 @@ constexpr inline class index_not_terms_t {
     }
 } index_not_terms{};
 
+/// the relation in a field term that an index can account for
+enum struct rel_op : std::uint8_t {
+    less,
+    less_equal,
+    greater,
+    greater_equal,
+    equal,
+    not_equal
+};
+
+constexpr inline class index_rel_terms_t {
+    template <match::matcher M>
+    friend constexpr auto tag_invoke(index_rel_terms_t, M const &m,
+                                     stdx::callable auto const &f,
+                                     std::size_t idx, bool negated = false)
+        -> void {
+        if constexpr (stdx::is_specialization_of_v<M, match::or_t> or
+                      stdx::is_specialization_of_v<M, match::and_t>) {
+            tag_invoke(index_rel_terms_t{}, m.lhs, f, idx, negated);
+            tag_invoke(index_rel_terms_t{}, m.rhs, f, idx, negated);
+        } else if constexpr (stdx::is_specialization_of_v<M, match::not_t>) {
+            tag_invoke(index_rel_terms_t{}, m.m, f, idx, not negated);
+        }
+    }
+
+  public:
+    template <typename... Ts>
+    constexpr auto operator()(Ts &&...ts) const
+        noexcept(noexcept(tag_invoke(std::declval<index_rel_terms_t>(),
+                                     std::forward<Ts>(ts)...)))
+            -> decltype(tag_invoke(*this, std::forward<Ts>(ts)...)) {
+        return tag_invoke(*this, std::forward<Ts>(ts)...);
+    }
+} index_rel_terms{};
+
 constexpr inline class remove_terms_t {
     template <match::matcher M, typename... Fields>
     [[nodiscard]] friend constexpr auto
@@ -114,6 +149,32 @@ template <typename RelOp> constexpr auto inverse_op() {
     }
 }
 
+template <typename RelOp> constexpr auto to_rel_op() -> rel_op {
+    if constexpr (std::same_as<RelOp, std::less<>>) {
+        return rel_op::less;
+    } else if constexpr (std::same_as<RelOp, std::less_equal<>>) {
+        return rel_op::less_equal;
+    } else if constexpr (std::same_as<RelOp, std::greater<>>) {
+        return rel_op::greater;
+    } else if constexpr (std::same_as<RelOp, std::greater_equal<>>) {
+        return rel_op::greater_equal;
+    } else if constexpr (std::same_as<RelOp, std::equal_to<>>) {
+        return rel_op::equal;
+    } else {
+        return rel_op::not_equal;
+    }
+}
+
+template <typename RelOp>
+concept range_op = std::same_as<RelOp, std::less<>> or
+                   std::same_as<RelOp, std::less_equal<>> or
+                   std::same_as<RelOp, std::greater<>> or
+                   std::same_as<RelOp, std::greater_equal<>>;
+
+/// range terms on fields of these types are indexed by intervals
+template <typename T>
+concept range_indexable = std::integral<T> and not std::same_as<T, bool>;
+
 template <typename RelOp> constexpr auto to_string() {
     using namespace stdx::literals;
     if constexpr (std::same_as<RelOp, std::less<>>) {
@@ -215,6 +276,34 @@ template <typename Field, auto ExpectedValue>
 constexpr auto greater_than_or_equal_to =
     greater_than_or_equal_to_t<Field, ExpectedValue>{};
 
+template <typename RelOp, typename Field, auto X>
+constexpr auto tag_invoke(index_rel_terms_t,
+                          rel_matcher_t<RelOp, Field, X> const &,
+                          stdx::callable auto const &f, std::size_t idx,
+                          bool negated = false) -> void {
+    if (negated) {
+        f.template operator()<Field>(
+            idx, detail::to_rel_op<decltype(detail::inverse_op<RelOp>())>(),
+            X);
+    } else {
+        f.template operator()<Field>(idx, detail::to_rel_op<RelOp>(), X);
+    }
+}
+
+// range terms on an indexed field are accounted for by its intervals
+template <detail::range_op RelOp, typename Field, auto X, typename... Fields>
+[[nodiscard]] constexpr auto tag_invoke(remove_terms_t,
+                                        rel_matcher_t<RelOp, Field, X> const &m,
+                                        std::type_identity<Fields>...)
+    -> match::matcher auto {
+    if constexpr (detail::range_indexable<typename Field::type> and
+                  (std::is_same_v<Field, Fields> or ...)) {
+        return match::always;
+    } else {
+        return m;
+    }
+}
+
 template <typename Field, auto X, decltype(X) Y>
 [[nodiscard]] constexpr auto
 tag_invoke(match::implies_t, less_than_or_equal_to_t<Field, X> const &,
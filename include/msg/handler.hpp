@@ -7,6 +7,9 @@
 #include <stdx/tuple_algorithms.hpp>
 #include <stdx/utility.hpp>
 
+#include <cstddef>
+#include <span>
+
 namespace msg {
 
 template <typename Nexus, stdx::tuplelike Callbacks, typename MsgBase,
@@ -38,6 +41,15 @@ struct handler : handler_interface<MsgBase, ExtraCallbackArgs...> {
         }
         return found_valid_callback;
     }
+
+    auto handle_batch(std::span<MsgBase const> msgs,
+                      ExtraCallbackArgs... args) const -> std::size_t final {
+        auto handled = std::size_t{};
+        for (auto const &msg : msgs) {
+            handled += handle(msg, args...) ? 1u : 0u;
+        }
+        return handled;
+    }
 };
 
 } // namespace msg
@@ -5,6 +5,9 @@
 #include <stdx/panic.hpp>
 #include <stdx/type_traits.hpp>
 
+#include <cstddef>
+#include <span>
+
 namespace msg {
 template <typename MsgBase, typename... ExtraCallbackArgs>
 struct handler_interface {
@@ -12,6 +15,19 @@ struct handler_interface {
 
     virtual auto handle(MsgBase const &msg,
                         ExtraCallbackArgs... extra_args) const -> bool = 0;
+
+    /// handle a burst of messages with one dispatch, returning the number of
+    /// them that some callback claimed. by default each message is handled
+    /// in turn; handlers that can do better override this
+    virtual auto handle_batch(std::span<MsgBase const> msgs,
+                              ExtraCallbackArgs... extra_args) const
+        -> std::size_t {
+        auto handled = std::size_t{};
+        for (auto const &msg : msgs) {
+            handled += handle(msg, extra_args...) ? 1u : 0u;
+        }
+        return handled;
+    }
 };
 
 namespace detail {
@@ -35,11 +51,22 @@ struct uninitialized_handler_t
     auto is_match(MsgBase const &) const -> bool override { return false; }
 
     auto handle(MsgBase const &, ExtraCallbackArgs...) const -> bool override {
+        not_initialized();
+        return false;
+    }
+
+    auto handle_batch(std::span<MsgBase const>, ExtraCallbackArgs...) const
+        -> std::size_t override {
+        not_initialized();
+        return 0;
+    }
+
+  private:
+    static auto not_initialized() -> void {
         using namespace stdx::literals;
         stdx::panic<"Attempting to handle msg ("_cts +
                     detail::name_for_msg<MsgBase>() +
                     ") before service is initialized"_cts>();
-        return false;
     }
 };
 } // namespace msg
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <log/log.hpp>
+#include <lookup/interval.hpp>
+#include <lookup/interval_lookup.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/strategies.hpp>
+#include <lookup/value_pool_lookup.hpp>
 #include <msg/detail/indexed_builder_common.hpp>
 #include <msg/indexed_handler.hpp>
 
@@ -9,10 +14,13 @@
 #include <stdx/tuple.hpp>
 #include <stdx/tuple_algorithms.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <iterator>
+#include <numeric>
 #include <type_traits>
+#include <utility>
 
 namespace msg {
 // TODO: needs index configuration
@@ -35,8 +43,8 @@ struct indexed_builder
     static consteval auto make_input() {
         struct {
             consteval auto operator()() const noexcept {
-                constexpr IndexSpec indices =
-                    base_t::template create_temp_indices<BuilderValue>();
+                constexpr auto const &indices =
+                    base_t::template temp_indices<BuilderValue>;
                 using key_type =
                     typename decltype(get<I>(indices).entries)::key_type;
                 using value_type = decltype(get<I>(indices).default_value);
@@ -49,27 +57,95 @@ struct indexed_builder
         } val;
         return val;
     }
+
+    // a field with range terms is indexed by its segments; the last segment,
+    // which runs up to the largest key, is the default
+    template <typename BuilderValue, typename I>
+    static consteval auto make_interval_input() {
+        struct {
+            consteval auto operator()() const noexcept {
+                constexpr auto const &indices =
+                    base_t::template temp_indices<BuilderValue>;
+                constexpr auto segs = get<I>(indices).segments(
+                    BuilderValue::value.callbacks.size());
+                using interval_t = lookup::interval<typename I::key_type,
+                                                    typename I::value_t>;
+                auto intervals = std::array<interval_t, segs.size - 1>{};
+                for (auto j = std::size_t{}; j < intervals.size(); ++j) {
+                    intervals[j] = {segs.entries[j].lo,
+                                    segs.entries[j + 1].lo,
+                                    segs.entries[j].value};
+                }
+                return lookup::interval_input{
+                    segs.entries[segs.size - 1].value, intervals};
+            }
+            using cx_value_t [[maybe_unused]] = void;
+        } val;
+        return val;
+    }
+
+    // the positions of the indices in the order they are looked up: the most
+    // selective first, so that a message that it rules out skips the others
+    template <typename BuilderValue>
+    constexpr static auto index_order = [] {
+        constexpr auto num_callbacks = BuilderValue::value.callbacks.size();
+        constexpr auto const &tmp_indices =
+            base_t::template temp_indices<BuilderValue>;
+        auto const selectivity = tmp_indices.apply([](auto const &...is) {
+            return std::array<double, sizeof...(is)>{
+                is.mean_candidates(num_callbacks)...};
+        });
+        auto order = std::array<std::size_t, stdx::tuple_size_v<IndexSpec>>{};
+        std::iota(order.begin(), order.end(), std::size_t{});
+        std::sort(order.begin(), order.end(), [&](auto l, auto r) {
+            return selectivity[l] < selectivity[r] or
+                   (not(selectivity[r] < selectivity[l]) and l < r);
+        });
+        return order;
+    }();
+
+    template <typename BuilderValue, std::size_t J>
+    using ordered_index_t = std::remove_cvref_t<
+        decltype(get<index_order<BuilderValue>[J]>(
+            std::declval<typename base_t::template temp_indices_t<
+                BuilderValue> const &>()))>;
+
     template <typename BuilderValue, typename Nexus>
     static consteval auto build() {
+        // index values are wide bitsets with few distinct values, so they
+        // are pooled where that saves space
         constexpr auto make_index_lookup =
             []<typename I, std::size_t... Es>(std::index_sequence<Es...>) {
-                return lookup::make(make_input<BuilderValue, I, Es...>());
+                using strategy_t = lookup::strategies<
+                    lookup::value_pool_lookup<lookup::default_strategy>,
+                    lookup::default_strategy>;
+                return strategy_t::make(make_input<BuilderValue, I, Es...>());
             };
 
-        constexpr IndexSpec temp_indices =
-            base_t::template create_temp_indices<BuilderValue>();
+        constexpr auto const &tmp_indices =
+            base_t::template temp_indices<BuilderValue>;
         auto const entry_index_seq = [&]<typename I>() {
             return std::make_index_sequence<
-                get<I>(temp_indices).entries.size()>{};
+                get<I>(tmp_indices).entries.size()>{};
+        };
+
+        auto const make_index = [&]<typename I>() {
+            if constexpr (get<I>(tmp_indices).has_range_terms) {
+                return index{typename I::field_type{},
+                             lookup::interval_lookup::make(
+                                 make_interval_input<BuilderValue, I>())};
+            } else {
+                return index{typename I::field_type{},
+                             make_index_lookup.template operator()<I>(
+                                 entry_index_seq.template operator()<I>())};
+            }
         };
 
         constexpr auto baked_indices =
-            temp_indices.apply([&]<typename... I>(I...) {
-                return indices{
-                    index{typename I::field_type{},
-                          make_index_lookup.template operator()<I>(
-                              entry_index_seq.template operator()<I>())}...};
-            });
+            [&]<std::size_t... Js>(std::index_sequence<Js...>) {
+                return indices{make_index.template operator()<
+                    ordered_index_t<BuilderValue, Js>>()...};
+            }(std::make_index_sequence<stdx::tuple_size_v<IndexSpec>>{});
 
         constexpr auto num_callbacks = BuilderValue::value.callbacks.size();
         constexpr auto callback_array =
@@ -4,15 +4,57 @@
 
 #include <stdx/bitset.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace msg {
 template <typename... Indices> struct indices : Indices... {
     consteval explicit indices(Indices... index_args)
         : Indices{index_args}... {}
 
+    // the indices are looked up in order, and once the candidates are empty
+    // the remaining indices are skipped
     constexpr auto operator()(auto const &data) const {
-        return (... & this->Indices::operator()(data));
+        using candidates_t = decltype((... & this->Indices::operator()(data)));
+        auto candidates = candidates_t{};
+        auto first = true;
+        auto const intersect = [&](auto const &idx) {
+            if (first) {
+                candidates = idx(data);
+                first = false;
+            } else {
+                candidates &= idx(data);
+            }
+            return not candidates.none();
+        };
+        static_cast<void>(
+            (... and intersect(static_cast<Indices const &>(*this))));
+        return candidates;
+    }
+
+    template <typename Msg, typename Candidates>
+    constexpr auto batch(std::span<Msg const> msgs,
+                         std::span<Candidates> candidates) const -> void {
+        auto partial = std::array<Candidates, detail::batch_chunk_size>{};
+        auto first = true;
+        auto const intersect = [&](auto const &idx) {
+            if (first) {
+                idx.batch(msgs, candidates);
+                first = false;
+            } else {
+                idx.batch(msgs, std::span{partial}.first(msgs.size()));
+                for (auto i = std::size_t{}; i < msgs.size(); ++i) {
+                    candidates[i] &= partial[i];
+                }
+            }
+            return std::any_of(candidates.begin(), candidates.end(),
+                               [](auto const &c) { return not c.none(); });
+        };
+        static_cast<void>(
+            (... and intersect(static_cast<Indices const &>(*this))));
     }
 };
 
@@ -23,5 +65,13 @@ template <> struct indices<> {
         -> stdx::bitset<0, std::uint32_t> {
         return {};
     }
+
+    template <typename Msg, typename Candidates>
+    constexpr auto batch(std::span<Msg const>,
+                         std::span<Candidates> candidates) const -> void {
+        for (auto &c : candidates) {
+            c = {};
+        }
+    }
 };
 } // namespace msg
@@ -0,0 +1,140 @@
+#include <lookup/batch.hpp>
+#include <lookup/hw_pext_lookup.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace {
+using linear_search = lookup::linear_search_lookup<8>;
+using pseudo_pext_direct = lookup::pseudo_pext_lookup<>;
+using pseudo_pext_indirect_1 = lookup::pseudo_pext_lookup<true, 1>;
+using pseudo_pext_indirect_3 = lookup::pseudo_pext_lookup<true, 3>;
+using hw_pext_direct = lookup::hw_pext_lookup<>;
+using hw_pext_indirect_2 = lookup::hw_pext_lookup<true, 2>;
+
+using pair_key = std::pair<std::uint16_t, std::uint16_t>;
+using tuple_key = std::tuple<std::int8_t, std::int16_t>;
+
+template <typename K> constexpr auto key(int a, int b) -> K {
+    return K{static_cast<std::tuple_element_t<0, K>>(a),
+             static_cast<std::tuple_element_t<1, K>>(b)};
+}
+
+// not a multiple of the batch chunk size, to exercise the remainder loop
+constexpr auto probe_keys = [] {
+    std::array<std::uint32_t, 45> keys{};
+    for (auto i = std::size_t{}; i < keys.size(); ++i) {
+        keys[i] = static_cast<std::uint32_t>(i * 37u % 400u);
+    }
+    keys[3] = 54u;
+    keys[17] = 324u;
+    keys[40] = 64u;
+    return keys;
+}();
+} // namespace
+
+TEMPLATE_TEST_CASE("batch lookup matches scalar lookup", "[batch]",
+                   linear_search, pseudo_pext_direct, pseudo_pext_indirect_1,
+                   pseudo_pext_indirect_3, hw_pext_direct,
+                   hw_pext_indirect_2) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, int, 6>{
+            -1, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                           lookup::entry{64u, 3}, lookup::entry{74u, 4},
+                           lookup::entry{111u, 5}, lookup::entry{0u, 6}}}));
+
+    auto values = std::array<int, probe_keys.size()>{};
+    lookup::batch(lookup, probe_keys, values);
+    for (auto i = std::size_t{}; i < probe_keys.size(); ++i) {
+        CHECK(values[i] == lookup[probe_keys[i]]);
+    }
+    CHECK(values[3] == 1);
+    CHECK(values[17] == 2);
+    CHECK(values[40] == 3);
+}
+
+TEMPLATE_TEST_CASE("batch lookup with no entries", "[batch]", linear_search,
+                   pseudo_pext_direct, pseudo_pext_indirect_1) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, int>{42}));
+
+    auto values = std::array<int, probe_keys.size()>{};
+    lookup::batch(lookup, probe_keys, values);
+    for (auto v : values) {
+        CHECK(v == 42);
+    }
+}
+
+TEMPLATE_TEST_CASE("batch lookup with non-integral values", "[batch]",
+                   linear_search, pseudo_pext_direct, pseudo_pext_indirect_3) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, double, 3>{
+            0.5, std::array{lookup::entry{54u, 3.4}, lookup::entry{324u, 5.2},
+                            lookup::entry{64u, 8.9}}}));
+
+    auto values = std::array<double, probe_keys.size()>{};
+    lookup::batch(lookup, probe_keys, values);
+    for (auto i = std::size_t{}; i < probe_keys.size(); ++i) {
+        CHECK(values[i] == lookup[probe_keys[i]]);
+    }
+}
+
+TEMPLATE_TEST_CASE("batch lookup of 4-byte composite keys matches scalar "
+                   "lookup",
+                   "[batch]", pair_key, tuple_key) {
+    // composite keys are stored packed, with the first field in the most
+    // significant bits, so their memory is not the stored key
+    constexpr auto lookup =
+        pseudo_pext_direct::make(CX_VALUE(lookup::input<TestType, int, 6>{
+            -1, std::array{lookup::entry{key<TestType>(1, 2), 1},
+                           lookup::entry{key<TestType>(2, 1), 2},
+                           lookup::entry{key<TestType>(3, 7), 3},
+                           lookup::entry{key<TestType>(7, 3), 4},
+                           lookup::entry{key<TestType>(-1, 5), 5},
+                           lookup::entry{key<TestType>(0, 0), 6}}}));
+
+    auto probes = std::array<TestType, 19>{};
+    for (auto i = std::size_t{}; i < probes.size(); ++i) {
+        probes[i] = key<TestType>(static_cast<int>(i % 8) - 1,
+                        static_cast<int>(i * 5 % 8));
+    }
+    probes[0] = key<TestType>(1, 2);
+    probes[5] = key<TestType>(2, 1);
+    probes[9] = key<TestType>(-1, 5);
+
+    auto values = std::array<int, probes.size()>{};
+    lookup::batch(lookup, probes, values);
+    for (auto i = std::size_t{}; i < probes.size(); ++i) {
+        CHECK(values[i] == lookup[probes[i]]);
+    }
+    CHECK(values[0] == 1);
+    CHECK(values[5] == 2);
+    CHECK(values[9] == 5);
+}
+
+TEST_CASE("batch lookup at compile time", "[batch]") {
+    constexpr auto lookup = lookup::make(CX_VALUE(lookup::input<int, int, 3>{
+        0, std::array{lookup::entry{0, 13}, lookup::entry{6, 42},
+                      lookup::entry{89, 10}}}));
+
+    constexpr auto values = [&] {
+        auto const keys = std::array{89, 1, 6, 0};
+        auto vs = std::array<int, 4>{};
+        lookup::batch(lookup, keys, vs);
+        return vs;
+    }();
+    STATIC_REQUIRE(values == std::array{10, 0, 42, 13});
+}
@@ -0,0 +1,22 @@
+# usage: cmake -DOBJDUMP=<objdump> -DOBJECT=<object file> -P check_no_branches.cmake
+#
+# fails if the disassembly of the object contains a conditional branch: x86
+# jcc (any jump other than jmp) or AArch64 b.cond, cbz/cbnz and tbz/tbnz
+
+execute_process(
+    COMMAND ${OBJDUMP} -d --no-show-raw-insn ${OBJECT}
+    OUTPUT_VARIABLE disassembly
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} failed on ${OBJECT}")
+endif()
+
+string(REGEX MATCHALL
+             "[0-9a-f]+:[ \t]+(j[a-ln-z][a-z]*|b\\.[a-z]+|cbn?z|tbn?z)[ \t][^\n]*"
+             branches "${disassembly}")
+if(branches)
+    string(REPLACE ";" "\n" branches "${branches}")
+    message(FATAL_ERROR "conditional branches found:\n${branches}\n\n"
+                        "${disassembly}")
+endif()
+message(STATUS "no conditional branches in ${OBJECT}")
@@ -0,0 +1,45 @@
+#include <lookup/detail/select.hpp>
+
+#include <array>
+#include <cstdint>
+
+// each function must compile to straight-line code: check_no_branches.cmake
+// fails if the disassembly contains a conditional branch
+
+namespace {
+struct wide_value {
+    std::array<std::uint64_t, 4> words;
+};
+} // namespace
+
+extern "C" {
+auto select_u32(std::uint32_t key, std::uint32_t k, std::uint32_t v,
+                std::uint32_t result) -> std::uint32_t {
+    return lookup::detail::select(key, k, v, result);
+}
+
+auto select_u16_u8(std::uint16_t key, std::uint16_t k, std::uint8_t v,
+                   std::uint8_t result) -> std::uint8_t {
+    return lookup::detail::select(key, k, v, result);
+}
+
+auto select_lt_i64(std::int64_t key, std::int64_t k, std::uint64_t v,
+                   std::uint64_t result) -> std::uint64_t {
+    return lookup::detail::select_lt(key, k, v, result);
+}
+
+auto select_lt_u64(std::uint64_t key, std::uint64_t k, std::size_t v,
+                   std::size_t result) -> std::size_t {
+    return lookup::detail::select_lt(key, k, v, result);
+}
+
+auto select_double(std::uint32_t key, std::uint32_t k, double v, double result)
+    -> double {
+    return lookup::detail::select(key, k, v, result);
+}
+
+auto select_wide(std::uint32_t key, std::uint32_t k, wide_value const *v,
+                 wide_value *result) -> void {
+    *result = lookup::detail::select(key, k, *v, *result);
+}
+}
@@ -0,0 +1,129 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/multiword_pext_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/two_level_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace {
+enum class msg_type : std::uint8_t { a = 1, b = 2, c = 7 };
+using msg_key_t = std::tuple<msg_type, std::uint16_t>;
+} // namespace
+
+TEST_CASE("composite keys pack with the first field most significant",
+          "[composite key]") {
+    using lookup::detail::as_raw_integral;
+    STATIC_REQUIRE(as_raw_integral(msg_key_t{msg_type::c, 0x1234}) ==
+                   std::uint32_t{0x07'1234});
+    STATIC_REQUIRE(std::is_same_v<lookup::detail::raw_integral_t<msg_key_t>,
+                                  std::uint32_t>);
+    STATIC_REQUIRE(as_raw_integral(std::pair{std::uint32_t{1},
+                                             std::uint32_t{2}}) ==
+                   0x1'0000'0002u);
+}
+
+TEST_CASE("signed fields of composite keys keep their order",
+          "[composite key]") {
+    using lookup::detail::as_ordered_integral;
+    STATIC_REQUIRE(as_ordered_integral(std::tuple{std::int8_t{-1}, 0}) <
+                   as_ordered_integral(std::tuple{std::int8_t{0}, 0}));
+    STATIC_REQUIRE(as_ordered_integral(std::tuple{0, std::int8_t{-1}}) <
+                   as_ordered_integral(std::tuple{0, std::int8_t{1}}));
+}
+
+TEST_CASE("pseudo_pext lookup with composite keys", "[composite key]") {
+    constexpr auto lookup = lookup::pseudo_pext_lookup<>::make(
+        CX_VALUE(lookup::input<msg_key_t, int, 4>{
+            0, std::array{lookup::entry{msg_key_t{msg_type::a, 1}, 1},
+                          lookup::entry{msg_key_t{msg_type::a, 2}, 2},
+                          lookup::entry{msg_key_t{msg_type::b, 1}, 3},
+                          lookup::entry{msg_key_t{msg_type::c, 500}, 4}}}));
+    CHECK(lookup[msg_key_t{msg_type::a, 1}] == 1);
+    CHECK(lookup[msg_key_t{msg_type::a, 2}] == 2);
+    CHECK(lookup[msg_key_t{msg_type::b, 1}] == 3);
+    CHECK(lookup[msg_key_t{msg_type::c, 500}] == 4);
+    CHECK(lookup[msg_key_t{msg_type::b, 2}] == 0);
+    CHECK(lookup[msg_key_t{msg_type::c, 1}] == 0);
+}
+
+TEST_CASE("linear search lookup with composite keys", "[composite key]") {
+    constexpr auto lookup = lookup::linear_search_lookup<4>::make(
+        CX_VALUE(lookup::input<msg_key_t, int, 2>{
+            0, std::array{lookup::entry{msg_key_t{msg_type::a, 1}, 1},
+                          lookup::entry{msg_key_t{msg_type::b, 1}, 2}}}));
+    CHECK(lookup[msg_key_t{msg_type::a, 1}] == 1);
+    CHECK(lookup[msg_key_t{msg_type::b, 1}] == 2);
+    CHECK(lookup[msg_key_t{msg_type::a, 2}] == 0);
+}
+
+TEST_CASE("lookup::make with composite keys", "[composite key]") {
+    constexpr auto lookup =
+        lookup::make(CX_VALUE(lookup::input<msg_key_t, int, 3>{
+            0, std::array{lookup::entry{msg_key_t{msg_type::a, 1}, 1},
+                          lookup::entry{msg_key_t{msg_type::b, 1}, 2},
+                          lookup::entry{msg_key_t{msg_type::c, 9}, 3}}}));
+    STATIC_REQUIRE(lookup[msg_key_t{msg_type::a, 1}] == 1);
+    STATIC_REQUIRE(lookup[msg_key_t{msg_type::b, 1}] == 2);
+    STATIC_REQUIRE(lookup[msg_key_t{msg_type::c, 9}] == 3);
+    STATIC_REQUIRE(lookup[msg_key_t{msg_type::c, 1}] == 0);
+}
+
+namespace {
+using wide_key_t = std::tuple<std::uint32_t, std::uint64_t>;
+}
+
+TEST_CASE("keys wider than 64 bits use two levels", "[composite key]") {
+    STATIC_REQUIRE(not lookup::detail::packable_key<wide_key_t>);
+    constexpr auto lookup =
+        lookup::two_level_lookup<lookup::default_strategy>::make(
+            CX_VALUE(lookup::input<wide_key_t, int, 4>{
+                -1,
+                std::array{lookup::entry{wide_key_t{1, 1}, 1},
+                           lookup::entry{wide_key_t{1, 0xffff'0000'0000}, 2},
+                           lookup::entry{wide_key_t{9, 1}, 3},
+                           lookup::entry{wide_key_t{1'000'000, 7}, 4}}}));
+    CHECK(lookup[wide_key_t{1, 1}] == 1);
+    CHECK(lookup[wide_key_t{1, 0xffff'0000'0000}] == 2);
+    CHECK(lookup[wide_key_t{9, 1}] == 3);
+    CHECK(lookup[wide_key_t{1'000'000, 7}] == 4);
+    CHECK(lookup[wide_key_t{9, 0xffff'0000'0000}] == -1);
+    CHECK(lookup[wide_key_t{2, 1}] == -1);
+    CHECK(lookup[wide_key_t{1'000'000, 1}] == -1);
+}
+
+TEST_CASE("two-level lookup recurses for very wide keys", "[composite key]") {
+    using key3_t = std::tuple<std::uint64_t, std::uint64_t, std::uint64_t>;
+    constexpr auto lookup =
+        lookup::two_level_lookup<lookup::default_strategy>::make(
+            CX_VALUE(lookup::input<key3_t, int, 3>{
+                0, std::array{lookup::entry{key3_t{1, 2, 3}, 1},
+                              lookup::entry{key3_t{1, 2, 4}, 2},
+                              lookup::entry{key3_t{5, 2, 3}, 3}}}));
+    STATIC_REQUIRE(lookup[key3_t{1, 2, 3}] == 1);
+    STATIC_REQUIRE(lookup[key3_t{1, 2, 4}] == 2);
+    STATIC_REQUIRE(lookup[key3_t{5, 2, 3}] == 3);
+    STATIC_REQUIRE(lookup[key3_t{5, 2, 4}] == 0);
+    STATIC_REQUIRE(lookup[key3_t{2, 2, 3}] == 0);
+}
+
+TEST_CASE("lookup::make only splits wide keys if word extraction fails",
+          "[composite key]") {
+    constexpr auto input = CX_VALUE(lookup::input<wide_key_t, int, 2>{
+        0, std::array{lookup::entry{wide_key_t{1, 1}, 1},
+                      lookup::entry{wide_key_t{9, 1}, 2}}});
+    STATIC_REQUIRE(std::is_same_v<
+                   decltype(lookup::make(input)),
+                   decltype(lookup::multiword_pext_lookup<
+                            lookup::default_strategy>::make(input))>);
+}
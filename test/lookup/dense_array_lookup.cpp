@@ -0,0 +1,91 @@
+#include <lookup/dense_array_lookup.hpp>
+#include <lookup/input.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+using DA = lookup::dense_array_lookup<>;
+}
+
+TEST_CASE("a lookup with no entries", "[dense array]") {
+    constexpr auto lookup = DA::make(CX_VALUE(lookup::input<int>{42}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("a lookup with a sparse key range", "[dense array]") {
+    constexpr auto lookup = DA::make(CX_VALUE(lookup::input<int, int, 3>{
+        0, std::array{lookup::entry{1, 1}, lookup::entry{2, 2},
+                      lookup::entry{7, 3}}}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("the span ratio is configurable", "[dense array]") {
+    constexpr auto lookup = lookup::dense_array_lookup<3>::make(
+        CX_VALUE(lookup::input<int, int, 3>{
+            0, std::array{lookup::entry{1, 1}, lookup::entry{2, 2},
+                          lookup::entry{7, 3}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    CHECK(lookup[7] == 3);
+    CHECK(lookup[5] == 0);
+}
+
+TEST_CASE("a lookup with a dense key range", "[dense array]") {
+    constexpr auto lookup =
+        DA::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 4>{
+            11u, std::array{lookup::entry{100u, 1u}, lookup::entry{101u, 2u},
+                            lookup::entry{103u, 4u},
+                            lookup::entry{104u, 5u}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    CHECK(lookup[99u] == 11u);
+    CHECK(lookup[100u] == 1u);
+    CHECK(lookup[101u] == 2u);
+    CHECK(lookup[102u] == 11u);
+    CHECK(lookup[103u] == 4u);
+    CHECK(lookup[104u] == 5u);
+    CHECK(lookup[105u] == 11u);
+    CHECK(lookup[0u] == 11u);
+    CHECK(lookup[0xffff'ffffu] == 11u);
+}
+
+TEST_CASE("a lookup with negative keys", "[dense array]") {
+    constexpr auto lookup = DA::make(CX_VALUE(lookup::input<int, int, 3>{
+        0, std::array{lookup::entry{-1, 1}, lookup::entry{0, 2},
+                      lookup::entry{1, 3}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    CHECK(lookup[-2] == 0);
+    CHECK(lookup[-1] == 1);
+    CHECK(lookup[0] == 2);
+    CHECK(lookup[1] == 3);
+    CHECK(lookup[2] == 0);
+}
+
+namespace {
+enum class opcode : std::uint8_t { NOP = 0x10, LOAD, STORE, JUMP = 0x14 };
+}
+
+TEST_CASE("a lookup with enum keys", "[dense array]") {
+    constexpr auto lookup = DA::make(CX_VALUE(lookup::input<opcode, int, 3>{
+        -1, std::array{lookup::entry{opcode::NOP, 1},
+                       lookup::entry{opcode::STORE, 2},
+                       lookup::entry{opcode::JUMP, 3}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    CHECK(lookup[opcode::NOP] == 1);
+    CHECK(lookup[opcode::LOAD] == -1);
+    CHECK(lookup[opcode::STORE] == 2);
+    CHECK(lookup[opcode::JUMP] == 3);
+}
+
+TEST_CASE("a lookup used at compile time", "[dense array]") {
+    constexpr auto lookup =
+        DA::make(CX_VALUE(lookup::input<std::uint16_t, float, 2>{
+            3.14f, std::array{lookup::entry<std::uint16_t, float>{5, 17.0f},
+                              lookup::entry<std::uint16_t, float>{6, 42.0f}}}));
+    STATIC_REQUIRE(lookup[std::uint16_t{5}] == 17.0f);
+    STATIC_REQUIRE(lookup[std::uint16_t{6}] == 42.0f);
+    STATIC_REQUIRE(lookup[std::uint16_t{7}] == 3.14f);
+}
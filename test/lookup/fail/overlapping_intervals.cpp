@@ -0,0 +1,14 @@
+#include <lookup/interval.hpp>
+#include <lookup/interval_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <array>
+
+// EXPECT: Lookup intervals must not overlap
+auto main() -> int {
+    [[maybe_unused]] constexpr auto lookup = lookup::interval_lookup::make(
+        CX_VALUE(lookup::interval_input<int, int, 2>{
+            0, std::array{lookup::interval{0, 10, 1},
+                          lookup::interval{5, 15, 2}}}));
+}
@@ -0,0 +1,106 @@
+#include <lookup/detail/pext.hpp>
+#include <lookup/hw_pext_lookup.hpp>
+#include <lookup/input.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+using hw_pext_direct = lookup::hw_pext_lookup<>;
+using hw_pext_indirect_1 = lookup::hw_pext_lookup<true, 1>;
+using hw_pext_indirect_2 = lookup::hw_pext_lookup<true, 2>;
+using hw_pext_indirect_3 = lookup::hw_pext_lookup<true, 3>;
+
+TEST_CASE("software pext", "[hw pext lookup]") {
+    STATIC_REQUIRE(lookup::detail::fallback_pext(0x1234u, 0xf0f0u) == 0x13u);
+    STATIC_REQUIRE(lookup::detail::hw_pext_t{0xf0f0u}(0x1234u) == 0x13u);
+    STATIC_REQUIRE(lookup::detail::hw_pext_t{0u}(0x1234u) == 0u);
+    STATIC_REQUIRE(lookup::detail::hw_pext_t{0xffff'ffffu}(0x1234u) ==
+                   0x1234u);
+}
+
+TEST_CASE("runtime pext matches software pext", "[hw pext lookup]") {
+    auto const masks = std::array{0xf0f0u,      0x8000'0001u, 0x0ff0'0f0fu,
+                                  0xffff'ffffu, 0x5555'5555u, 0u};
+    auto const values =
+        std::array{0u, 0x1234u, 0xdead'beefu, 0xffff'ffffu, 0x8000'0000u};
+    for (auto m : masks) {
+        auto const p = lookup::detail::hw_pext_t{m};
+        for (auto v : values) {
+            CHECK(p(v) == lookup::detail::fallback_pext(v, m));
+            CHECK(p.soft_pext(v) == lookup::detail::fallback_pext(v, m));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("lookup with some entries", "[hw pext lookup]",
+                   hw_pext_direct, hw_pext_indirect_1, hw_pext_indirect_2,
+                   hw_pext_indirect_3) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t, int, 3>{
+            0, std::array{lookup::entry{54u, 1}, lookup::entry{324u, 2},
+                          lookup::entry{64u, 3}}}));
+
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 1);
+    CHECK(lookup[324] == 2);
+    CHECK(lookup[64] == 3);
+    STATIC_REQUIRE(lookup[324] == 2);
+}
+
+TEMPLATE_TEST_CASE("lookup with no entries", "[hw pext lookup]",
+                   hw_pext_direct, hw_pext_indirect_1, hw_pext_indirect_2,
+                   hw_pext_indirect_3) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint32_t>{0}));
+
+    CHECK(lookup[0] == 0);
+    CHECK(lookup[54] == 0);
+}
+
+TEMPLATE_TEST_CASE("lookup with 64-bit keys", "[hw pext lookup]",
+                   hw_pext_direct, hw_pext_indirect_1, hw_pext_indirect_2,
+                   hw_pext_indirect_3) {
+    using entry_t = lookup::entry<std::uint64_t, int>;
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<std::uint64_t, int, 5>{
+            -1, std::array{entry_t{0x1'0000'0000u, 1},
+                           entry_t{0x8000'0000'0000'0000u, 2},
+                           entry_t{0x42u, 3}, entry_t{0x1'0000'0042u, 4},
+                           entry_t{0u, 5}}}));
+
+    CHECK(lookup[0x1'0000'0000u] == 1);
+    CHECK(lookup[0x8000'0000'0000'0000u] == 2);
+    CHECK(lookup[0x42u] == 3);
+    CHECK(lookup[0x1'0000'0042u] == 4);
+    CHECK(lookup[0u] == 5);
+    CHECK(lookup[0x43u] == -1);
+    CHECK(lookup[0x8000'0000'0000'0042u] == -1);
+}
+
+enum class some_key_t : std::uint16_t {
+    ALPHA = 0u,
+    BETA = 1u,
+    KAPPA = 2u,
+    GAMMA = 3u
+};
+
+TEMPLATE_TEST_CASE("lookup with scoped enum entries", "[hw pext lookup]",
+                   hw_pext_direct, hw_pext_indirect_1, hw_pext_indirect_2,
+                   hw_pext_indirect_3) {
+    constexpr auto lookup =
+        TestType::make(CX_VALUE(lookup::input<some_key_t, std::int8_t, 4>{
+            0, std::array{
+                   lookup::entry<some_key_t, int8_t>{some_key_t::ALPHA, 54},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::BETA, 23},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::KAPPA, 87},
+                   lookup::entry<some_key_t, int8_t>{some_key_t::GAMMA, 4}}}));
+
+    CHECK(lookup[some_key_t::ALPHA] == 54);
+    CHECK(lookup[some_key_t::BETA] == 23);
+    CHECK(lookup[some_key_t::KAPPA] == 87);
+    CHECK(lookup[some_key_t::GAMMA] == 4);
+}
@@ -0,0 +1,137 @@
+#include <lookup/arena.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/info.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/prefilter_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/radix_trie_lookup.hpp>
+#include <lookup/runtime_lookup.hpp>
+#include <lookup/string_lookup.hpp>
+#include <lookup/two_level_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+
+namespace {
+using namespace std::string_view_literals;
+
+template <std::size_t N> constexpr auto spread_entries() {
+    auto entries = std::array<lookup::entry<std::uint32_t, std::uint32_t>, N>{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        auto const k = static_cast<std::uint32_t>((i + 1) * 0x9e37'79b9u);
+        entries[i] = {k, static_cast<std::uint32_t>(i + 1)};
+    }
+    return entries;
+}
+
+constexpr auto spread = spread_entries<128>();
+} // namespace
+
+TEST_CASE("linear search describes itself", "[info]") {
+    constexpr auto t = lookup::linear_search_lookup<4>::make(
+        CX_VALUE(lookup::input{0, std::array{lookup::entry{1, 1},
+                                             lookup::entry{2, 2}}}));
+    constexpr auto i = lookup::info(t);
+    STATIC_REQUIRE(i.strategy() == "linear_search"sv);
+    STATIC_REQUIRE(i.bytes == sizeof(t));
+    STATIC_REQUIRE(i.mask == 0);
+    STATIC_REQUIRE(i.max_probes == 2);
+    STATIC_REQUIRE(i.average_probes == 2);
+}
+
+TEST_CASE("indirect pext tables report mask and probe lengths", "[info]") {
+    constexpr auto t = lookup::pseudo_pext_lookup<true, 2>::make(CX_VALUE(
+        lookup::input<std::uint32_t, std::uint32_t, 128>{0, spread}));
+    constexpr auto i = lookup::info(t);
+    STATIC_REQUIRE(i.strategy() == "pseudo_pext"sv);
+    STATIC_REQUIRE(i.bytes == sizeof(t));
+    STATIC_REQUIRE(i.mask == t.pext_func.mask);
+    STATIC_REQUIRE(i.max_probes == t.search_len + 1);
+    STATIC_REQUIRE(i.average_probes >= 2);
+    STATIC_REQUIRE(i.average_probes < static_cast<double>(i.max_probes));
+
+    // a size budget, as a build might assert it
+    STATIC_REQUIRE(lookup::info(t).bytes <= 2048);
+}
+
+TEST_CASE("the chosen strategy is reported", "[info]") {
+    constexpr auto dense = lookup::make(CX_VALUE(lookup::input{
+        0, std::array{lookup::entry{1u, 1}, lookup::entry{2u, 2},
+                      lookup::entry{3u, 3}}}));
+    STATIC_REQUIRE(lookup::info(dense).strategy() == "dense_array"sv);
+
+    constexpr auto sparse = lookup::make(CX_VALUE(
+        lookup::input<std::uint32_t, std::uint32_t, 128>{0, spread}));
+    STATIC_REQUIRE(lookup::info(sparse).strategy() == "pseudo_pext"sv);
+}
+
+TEST_CASE("wrappers name the table inside them", "[info]") {
+    constexpr auto t =
+        lookup::prefilter_lookup<lookup::pseudo_pext_lookup<true, 2>>::make(
+            CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 128>{
+                0, spread}));
+    constexpr auto i = lookup::info(t);
+    constexpr auto inner = lookup::info(t.table);
+    STATIC_REQUIRE(i.strategy() == "prefilter(pseudo_pext)"sv);
+    STATIC_REQUIRE(i.bytes == sizeof(t));
+    STATIC_REQUIRE(i.mask == inner.mask);
+    STATIC_REQUIRE(i.max_probes == inner.max_probes + 1);
+    STATIC_REQUIRE(i.average_probes == inner.average_probes + 1);
+
+    constexpr auto s = lookup::make(CX_VALUE(lookup::input{
+        0, std::array{lookup::string_entry<"get">(1),
+                      lookup::string_entry<"put">(2),
+                      lookup::string_entry<"post">(3)}}));
+    STATIC_REQUIRE(lookup::info(s).strategy().starts_with("string("));
+}
+
+TEST_CASE("two-level tables add up their fields", "[info]") {
+    using wide_key_t = std::tuple<std::uint32_t, std::uint64_t>;
+    constexpr auto t =
+        lookup::two_level_lookup<lookup::default_strategy>::make(
+            CX_VALUE(lookup::input<wide_key_t, int, 3>{
+                -1, std::array{lookup::entry{wide_key_t{1, 1}, 1},
+                               lookup::entry{wide_key_t{1, 1ull << 40}, 2},
+                               lookup::entry{wide_key_t{9, 1}, 3}}}));
+    constexpr auto i = lookup::info(t);
+    STATIC_REQUIRE(i.strategy().starts_with("two_level("));
+    STATIC_REQUIRE(i.max_probes ==
+                   lookup::info(t.ids).max_probes +
+                       lookup::info(std::get<0>(t.fields)).max_probes +
+                       lookup::info(std::get<1>(t.fields)).max_probes);
+}
+
+TEST_CASE("trie reports the depth of its entries", "[info]") {
+    constexpr auto t = lookup::radix_trie_lookup<>::make(
+        CX_VALUE(lookup::input{0, std::array{lookup::entry{0x10'0000u, 1},
+                                             lookup::entry{0x10'0001u, 2},
+                                             lookup::entry{0u, 3}}}));
+    constexpr auto i = lookup::info(t);
+    STATIC_REQUIRE(i.strategy() == "radix_trie"sv);
+    STATIC_REQUIRE(i.max_probes == 5);
+    // one key is found at the root, two at the fourth level
+    STATIC_REQUIRE(i.average_probes == (2.0 + 5 + 5) / 3);
+}
+
+TEST_CASE("runtime tables describe themselves", "[info]") {
+    auto arena = lookup::fixed_arena<8192>{};
+    auto const rt = lookup::build_runtime<2>(0u, spread, arena);
+    REQUIRE(rt.has_value());
+    constexpr auto ct = lookup::pseudo_pext_lookup<true, 2>::make(CX_VALUE(
+        lookup::input<std::uint32_t, std::uint32_t, 128>{0, spread}));
+
+    auto const i = lookup::info(*rt);
+    CHECK(i.strategy() == "pseudo_pext_runtime");
+    CHECK(i.bytes == rt->cost().bytes);
+    CHECK(i.mask == ct.pext_func.mask);
+    CHECK(i.average_probes == lookup::info(ct).average_probes);
+}
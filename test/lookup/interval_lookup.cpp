@@ -0,0 +1,125 @@
+#include <lookup/interval.hpp>
+#include <lookup/interval_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+using IL = lookup::interval_lookup;
+}
+
+TEST_CASE("a lookup with no intervals", "[interval lookup]") {
+    constexpr auto lookup = IL::make(CX_VALUE(lookup::interval_input<int>{42}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    CHECK(lookup[0] == 42);
+    CHECK(lookup[-1] == 42);
+}
+
+TEST_CASE("a lookup with one interval", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<std::uint32_t, int, 1>{
+            0, std::array{lookup::interval{10u, 20u, 1}}}));
+    CHECK(lookup[0u] == 0);
+    CHECK(lookup[9u] == 0);
+    CHECK(lookup[10u] == 1);
+    CHECK(lookup[19u] == 1);
+    CHECK(lookup[20u] == 0);
+    CHECK(lookup[0xffff'ffffu] == 0);
+}
+
+TEST_CASE("a lookup with disjoint intervals", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<std::uint32_t, int, 3>{
+            -1, std::array{lookup::interval{300u, 400u, 3},
+                           lookup::interval{10u, 20u, 1},
+                           lookup::interval{100u, 101u, 2}}}));
+    CHECK(lookup[5u] == -1);
+    CHECK(lookup[10u] == 1);
+    CHECK(lookup[15u] == 1);
+    CHECK(lookup[20u] == -1);
+    CHECK(lookup[99u] == -1);
+    CHECK(lookup[100u] == 2);
+    CHECK(lookup[101u] == -1);
+    CHECK(lookup[299u] == -1);
+    CHECK(lookup[300u] == 3);
+    CHECK(lookup[399u] == 3);
+    CHECK(lookup[400u] == -1);
+    CHECK(lookup[0xffff'ffffu] == -1);
+}
+
+TEST_CASE("a lookup with abutting intervals", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<std::uint8_t, int, 3>{
+            0, std::array{lookup::interval<std::uint8_t, int>{0, 10, 1},
+                          lookup::interval<std::uint8_t, int>{10, 20, 2},
+                          lookup::interval<std::uint8_t, int>{20, 255, 3}}}));
+    CHECK(lookup[0] == 1);
+    CHECK(lookup[9] == 1);
+    CHECK(lookup[10] == 2);
+    CHECK(lookup[19] == 2);
+    CHECK(lookup[20] == 3);
+    CHECK(lookup[254] == 3);
+    CHECK(lookup[255] == 0);
+}
+
+TEST_CASE("a lookup with negative keys", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<int, int, 2>{
+            0, std::array{lookup::interval{-100, -10, 1},
+                          lookup::interval{-5, 5, 2}}}));
+    CHECK(lookup[-101] == 0);
+    CHECK(lookup[-100] == 1);
+    CHECK(lookup[-11] == 1);
+    CHECK(lookup[-10] == 0);
+    CHECK(lookup[-5] == 2);
+    CHECK(lookup[4] == 2);
+    CHECK(lookup[5] == 0);
+}
+
+namespace {
+enum class level : std::int8_t { low = -10, mid = 0, high = 10, max = 100 };
+}
+
+TEST_CASE("a lookup with enum keys", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<level, int, 2>{
+            0, std::array{lookup::interval{level::low, level::mid, 1},
+                          lookup::interval{level::high, level::max, 2}}}));
+    CHECK(lookup[level::low] == 1);
+    CHECK(lookup[level::mid] == 0);
+    CHECK(lookup[level::high] == 2);
+    CHECK(lookup[level::max] == 0);
+}
+
+TEST_CASE("lookup can be used at compile time", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<std::uint32_t, int, 2>{
+            0, std::array{lookup::interval{10u, 20u, 1},
+                          lookup::interval{30u, 40u, 2}}}));
+    STATIC_REQUIRE(lookup[9u] == 0);
+    STATIC_REQUIRE(lookup[10u] == 1);
+    STATIC_REQUIRE(lookup[35u] == 2);
+    STATIC_REQUIRE(lookup[40u] == 0);
+}
+
+TEST_CASE("interval lookup reports its cost", "[interval lookup]") {
+    constexpr auto lookup =
+        IL::make(CX_VALUE(lookup::interval_input<std::uint32_t, int, 2>{
+            0, std::array{lookup::interval{10u, 20u, 1},
+                          lookup::interval{30u, 40u, 2}}}));
+    // four boundaries are padded to seven: three levels of search
+    STATIC_REQUIRE(lookup::cost(lookup).probes == 4);
+}
+
+TEST_CASE("interval lookup can be used as a strategy", "[interval lookup]") {
+    constexpr auto lookup = lookup::strategies<IL>::make(
+        CX_VALUE(lookup::interval_input<std::uint32_t, int, 1>{
+            0, std::array{lookup::interval{10u, 20u, 1}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    CHECK(lookup[15u] == 1);
+}
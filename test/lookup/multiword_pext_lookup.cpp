@@ -0,0 +1,106 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/multiword_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+namespace {
+using MW = lookup::multiword_pext_lookup<lookup::default_strategy>;
+using guid_t = std::array<std::uint32_t, 4>;
+
+constexpr auto guids = std::array{
+    lookup::entry{guid_t{0x6ba7'b810, 0x9dad'11d1, 0x80b4'00c0, 0x4fd4'30c8},
+                  1},
+    lookup::entry{guid_t{0x6ba7'b811, 0x9dad'11d1, 0x80b4'00c0, 0x4fd4'30c8},
+                  2},
+    lookup::entry{guid_t{0x6ba7'b812, 0x9dad'11d1, 0x80b4'00c0, 0x4fd4'30c8},
+                  3},
+    lookup::entry{guid_t{0x0000'0000, 0x0000'0000, 0x0000'0000, 0x0000'0001},
+                  4},
+    lookup::entry{guid_t{0xffff'ffff, 0xffff'ffff, 0xffff'ffff, 0xffff'ffff},
+                  5},
+};
+} // namespace
+
+TEST_CASE("keys are split into 64-bit words", "[multiword pext]") {
+    using lookup::detail::as_words;
+    STATIC_REQUIRE(lookup::detail::num_key_words<guid_t> == 2);
+    STATIC_REQUIRE(as_words(guid_t{1, 2, 3, 4}) ==
+                   std::array<std::uint64_t, 2>{0x2'0000'0001,
+                                                0x4'0000'0003});
+    STATIC_REQUIRE(
+        lookup::detail::num_key_words<
+            std::tuple<std::uint32_t, std::uint64_t, std::uint32_t>> == 3);
+}
+
+TEST_CASE("only discriminating bits are extracted", "[multiword pext]") {
+    constexpr auto lookup = MW::make(CX_VALUE(lookup::input{0, guids}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    STATIC_REQUIRE(lookup.extract.bits <= 4);
+}
+
+TEST_CASE("multiword lookup of array keys", "[multiword pext]") {
+    constexpr auto lookup = MW::make(CX_VALUE(lookup::input{0, guids}));
+    for (auto const &[k, v] : guids) {
+        CHECK(lookup[k] == v);
+    }
+    // keys that share the extracted bits of an entry are still misses
+    CHECK(lookup[guid_t{0x6ba7'b810, 0x9dad'11d1, 0x80b4'00c0, 0x4fd4'30c9}] ==
+          0);
+    CHECK(lookup[guid_t{0x6ba7'b813, 0x9dad'11d1, 0x80b4'00c0, 0x4fd4'30c8}] ==
+          0);
+    CHECK(lookup[guid_t{}] == 0);
+    CHECK(lookup[guid_t{0, 0, 0, 2}] == 0);
+}
+
+#if defined(__SIZEOF_INT128__)
+namespace {
+using u128 = lookup::detail::uint128_t;
+
+constexpr auto wide(std::uint64_t hi, std::uint64_t lo) -> u128 {
+    return (static_cast<u128>(hi) << 64u) | lo;
+}
+} // namespace
+
+TEST_CASE("multiword lookup of 128-bit keys", "[multiword pext]") {
+    STATIC_REQUIRE(not lookup::detail::packable_key<u128>);
+    constexpr auto lookup = MW::make(CX_VALUE(lookup::input{
+        -1, std::array{lookup::entry{wide(1, 0), 10},
+                       lookup::entry{wide(0, 1), 11},
+                       lookup::entry{wide(0x8000'0000'0000'0000, 0), 12},
+                       lookup::entry{wide(0xdead'beef, 0xcafe'f00d), 13}}}));
+    STATIC_REQUIRE(lookup[wide(1, 0)] == 10);
+    STATIC_REQUIRE(lookup[wide(0, 1)] == 11);
+    STATIC_REQUIRE(lookup[wide(0x8000'0000'0000'0000, 0)] == 12);
+    STATIC_REQUIRE(lookup[wide(0xdead'beef, 0xcafe'f00d)] == 13);
+    STATIC_REQUIRE(lookup[wide(1, 1)] == -1);
+    STATIC_REQUIRE(lookup[wide(0, 0)] == -1);
+    STATIC_REQUIRE(lookup[wide(0xdead'beef, 0)] == -1);
+}
+
+TEST_CASE("lookup::make with 128-bit keys", "[multiword pext]") {
+    constexpr auto lookup = lookup::make(CX_VALUE(lookup::input{
+        0, std::array{lookup::entry{wide(5, 5), 1},
+                      lookup::entry{wide(6, 5), 2},
+                      lookup::entry{wide(5, 6), 3}}}));
+    CHECK(lookup[wide(5, 5)] == 1);
+    CHECK(lookup[wide(6, 5)] == 2);
+    CHECK(lookup[wide(5, 6)] == 3);
+    CHECK(lookup[wide(6, 6)] == 0);
+}
+#endif
+
+TEST_CASE("lookup::make with multi-word array keys", "[multiword pext]") {
+    constexpr auto lookup = lookup::make(CX_VALUE(lookup::input{0, guids}));
+    for (auto const &[k, v] : guids) {
+        CHECK(lookup[k] == v);
+    }
+    CHECK(lookup[guid_t{1, 2, 3, 4}] == 0);
+}
@@ -0,0 +1,88 @@
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/perfect_hash_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+using PH = lookup::perfect_hash_lookup<>;
+
+template <typename K, std::size_t N> constexpr auto make_input() {
+    // keys that differ only in high-entropy bits
+    std::array<lookup::entry<K, int>, N> entries{};
+    auto k = std::uint64_t{0x2545'f491'4f6c'dd1du};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        k ^= k << 13u;
+        k ^= k >> 7u;
+        k ^= k << 17u;
+        entries[i] = {static_cast<K>(k | 1u), static_cast<int>(i + 1)};
+    }
+    return lookup::input<K, int, N>{0, entries};
+}
+} // namespace
+
+TEST_CASE("a lookup with no entries", "[perfect hash]") {
+    constexpr auto lookup = PH::make(CX_VALUE(lookup::input<int>{42}));
+    CHECK(lookup[0] == 42);
+    CHECK(lookup[17] == 42);
+}
+
+TEST_CASE("a lookup with some entries", "[perfect hash]") {
+    constexpr auto lookup =
+        PH::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 3>{
+            11u, std::array{lookup::entry{0u, 17u}, lookup::entry{6u, 42u},
+                            lookup::entry{89u, 10u}}}));
+    CHECK(lookup[0u] == 17u);
+    CHECK(lookup[1u] == 11u);
+    CHECK(lookup[6u] == 42u);
+    CHECK(lookup[89u] == 10u);
+    CHECK(lookup[90u] == 11u);
+}
+
+TEST_CASE("table size is independent of key bits", "[perfect hash]") {
+    constexpr auto input = make_input<std::uint32_t, 100>();
+    constexpr auto lookup = PH::make(CX_VALUE(input));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    STATIC_REQUIRE(lookup.storage.size() == 120);
+
+    for (auto const &e : input.entries) {
+        CHECK(lookup[e.key_] == e.value_);
+        CHECK(lookup[e.key_ ^ 1u] == 0);
+    }
+}
+
+TEST_CASE("a lookup with 64-bit keys", "[perfect hash]") {
+    constexpr auto input = make_input<std::uint64_t, 50>();
+    constexpr auto lookup = PH::make(CX_VALUE(input));
+    for (auto const &e : input.entries) {
+        CHECK(lookup[e.key_] == e.value_);
+        CHECK(lookup[e.key_ - 1u] == 0);
+    }
+}
+
+TEST_CASE("a lookup used at compile time", "[perfect hash]") {
+    constexpr auto lookup =
+        PH::make(CX_VALUE(lookup::input<std::uint16_t, float, 2>{
+            3.14f,
+            std::array{lookup::entry<std::uint16_t, float>{5, 17.0f},
+                       lookup::entry<std::uint16_t, float>{0x8000, 42.0f}}}));
+    STATIC_REQUIRE(lookup[std::uint16_t{5}] == 17.0f);
+    STATIC_REQUIRE(lookup[std::uint16_t{0x8000}] == 42.0f);
+    STATIC_REQUIRE(lookup[std::uint16_t{7}] == 3.14f);
+}
+
+TEST_CASE("selectable as a strategy", "[perfect hash]") {
+    using S = lookup::strategies<lookup::linear_search_lookup<2>, PH>;
+    constexpr auto input = make_input<std::uint32_t, 10>();
+    constexpr auto lookup = S::make(CX_VALUE(input));
+    for (auto const &e : input.entries) {
+        CHECK(lookup[e.key_] == e.value_);
+    }
+}
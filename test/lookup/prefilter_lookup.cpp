@@ -0,0 +1,93 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/prefilter_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+
+namespace {
+using PF = lookup::prefilter_lookup<lookup::pseudo_pext_lookup<true, 2>>;
+
+template <std::size_t N> constexpr auto spread_entries() {
+    auto entries = std::array<lookup::entry<std::uint32_t, std::uint32_t>, N>{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        auto const k = static_cast<std::uint32_t>((i + 1) * 0x9e37'79b9u);
+        entries[i] = {k, static_cast<std::uint32_t>(i + 1)};
+    }
+    return entries;
+}
+} // namespace
+
+TEST_CASE("prefiltered lookup finds every entry", "[prefilter]") {
+    constexpr auto lookup = PF::make(CX_VALUE(lookup::input{
+        0, std::array{lookup::entry{10u, 1}, lookup::entry{200u, 2},
+                      lookup::entry{3000u, 3}, lookup::entry{40000u, 4}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    STATIC_REQUIRE(lookup[10u] == 1);
+    STATIC_REQUIRE(lookup[200u] == 2);
+    STATIC_REQUIRE(lookup[3000u] == 3);
+    STATIC_REQUIRE(lookup[40000u] == 4);
+    STATIC_REQUIRE(lookup[11u] == 0);
+    STATIC_REQUIRE(lookup[0u] == 0);
+}
+
+TEST_CASE("the prefilter has no false negatives", "[prefilter]") {
+    constexpr static auto entries = spread_entries<500>();
+    constexpr auto lookup =
+        PF::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 500>{
+            0, entries}));
+    for (auto const &[k, v] : entries) {
+        CHECK(lookup.may_contain(k));
+        CHECK(lookup[k] == v);
+    }
+}
+
+TEST_CASE("the prefilter rejects most misses", "[prefilter]") {
+    constexpr static auto entries = spread_entries<1000>();
+    constexpr auto lookup =
+        PF::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 1000>{
+            0, entries}));
+    STATIC_REQUIRE(sizeof(lookup.filter) == 1024);
+
+    auto rng = std::mt19937{1};
+    auto false_positives = 0;
+    auto misses = 0;
+    for (auto i = 0; i < 100'000; ++i) {
+        auto const k = static_cast<std::uint32_t>(rng());
+        if (std::none_of(entries.begin(), entries.end(),
+                         [&](auto const &e) { return e.key_ == k; })) {
+            ++misses;
+            false_positives += lookup.may_contain(k) ? 1 : 0;
+            CHECK(lookup[k] == 0);
+        }
+    }
+    CHECK(false_positives * 100 < misses * 5);
+}
+
+TEST_CASE("prefilter with composite keys", "[prefilter]") {
+    using pair_key_t = std::tuple<std::uint8_t, std::uint16_t>;
+    constexpr auto lookup = PF::make(CX_VALUE(lookup::input{
+        -1, std::array{lookup::entry{pair_key_t{1, 2}, 5},
+                       lookup::entry{pair_key_t{2, 1}, 6}}}));
+    STATIC_REQUIRE(lookup[pair_key_t{1, 2}] == 5);
+    STATIC_REQUIRE(lookup[pair_key_t{2, 1}] == 6);
+    STATIC_REQUIRE(lookup[pair_key_t{1, 1}] == -1);
+}
+
+TEST_CASE("prefilter fails when its table does", "[prefilter]") {
+    constexpr auto lookup =
+        lookup::prefilter_lookup<lookup::linear_search_lookup<1>>::make(
+            CX_VALUE(lookup::input{0, std::array{lookup::entry{1, 1},
+                                                 lookup::entry{2, 2}}}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
@@ -0,0 +1,124 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/profiled_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+constexpr auto routes = std::array{
+    lookup::entry{10u, 1}, lookup::entry{20u, 2}, lookup::entry{30u, 3},
+    lookup::entry{40u, 4}};
+
+constexpr auto route_profile = lookup::profile<unsigned, 3>{
+    {{30u, 900}, {20u, 90}, {99u, 5000}}};
+
+// keys whose low bits collide often, with later keys more frequent
+template <std::size_t N> constexpr auto spread_entries() {
+    auto entries = std::array<lookup::entry<std::uint32_t, std::uint32_t>, N>{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        auto const k = static_cast<std::uint32_t>((i + 1) * 0x9e37'79b9u);
+        entries[i] = {k, static_cast<std::uint32_t>(i + 1)};
+    }
+    return entries;
+}
+
+template <std::size_t N> constexpr auto spread_profile() {
+    auto p = lookup::profile<std::uint32_t, N>{};
+    auto const entries = spread_entries<N>();
+    for (auto i = std::size_t{}; i < N; ++i) {
+        p[i] = {entries[i].key_, i * i};
+    }
+    return p;
+}
+
+constexpr auto spread = spread_entries<128>();
+constexpr auto spread_counts = spread_profile<128>();
+
+// the number of entries compared to find each key, weighted by how often it
+// is looked up
+constexpr auto weighted_probes(auto const &table) -> std::uint64_t {
+    auto total = std::uint64_t{};
+    for (auto const &[k, n] : spread_counts) {
+        auto i = table.lookup_table[table.pext_func(k)];
+        auto probes = std::uint64_t{1};
+        while (table.storage[i].key_ != k) {
+            ++i;
+            ++probes;
+        }
+        total += n * probes;
+    }
+    return total;
+}
+} // namespace
+
+TEST_CASE("linear search meets the hot keys first", "[profiled lookup]") {
+    constexpr auto lookup =
+        lookup::profiled_lookup<lookup::linear_search_lookup<4>,
+                                route_profile>::make(CX_VALUE(lookup::input{
+            0, routes}));
+    STATIC_REQUIRE(lookup.entries[0].key_ == 30u);
+    STATIC_REQUIRE(lookup.entries[1].key_ == 20u);
+    STATIC_REQUIRE(lookup.entries[2].key_ == 10u);
+    STATIC_REQUIRE(lookup.entries[3].key_ == 40u);
+
+    STATIC_REQUIRE(lookup[10u] == 1);
+    STATIC_REQUIRE(lookup[20u] == 2);
+    STATIC_REQUIRE(lookup[30u] == 3);
+    STATIC_REQUIRE(lookup[40u] == 4);
+    STATIC_REQUIRE(lookup[99u] == 0);
+}
+
+TEST_CASE("colliding keys are compared most frequent first",
+          "[profiled lookup]") {
+    using S = lookup::pseudo_pext_lookup<true, 2>;
+    constexpr auto plain = S::make(
+        CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 128>{0, spread}));
+    constexpr auto profiled =
+        lookup::profiled_lookup<S, spread_counts>::make(CX_VALUE(
+            lookup::input<std::uint32_t, std::uint32_t, 128>{0, spread}));
+
+    for (auto const &[k, v] : spread) {
+        CHECK(profiled[k] == v);
+        CHECK(plain[k] == v);
+    }
+    CHECK(profiled[0u] == 0);
+
+    auto collisions = 0;
+    auto const count = [](std::uint32_t k) {
+        for (auto const &[key, n] : spread_counts) {
+            if (key == k) {
+                return n;
+            }
+        }
+        return std::uint64_t{};
+    };
+    for (auto i = std::size_t{1}; i < 128; ++i) {
+        auto const &prev = profiled.storage[i - 1];
+        auto const &curr = profiled.storage[i];
+        if (profiled.pext_func(prev.key_) == profiled.pext_func(curr.key_)) {
+            ++collisions;
+            CHECK(count(prev.key_) >= count(curr.key_));
+        }
+    }
+    CHECK(collisions > 0);
+    CHECK(weighted_probes(profiled) < weighted_probes(plain));
+}
+
+TEST_CASE("keys outside the profile keep their order", "[profiled lookup]") {
+    constexpr auto lookup =
+        lookup::profiled_lookup<lookup::linear_search_lookup<4>,
+                                lookup::profile<unsigned, 0>{}>::
+            make(CX_VALUE(lookup::input{0, routes}));
+    STATIC_REQUIRE(lookup.entries[0].key_ == 10u);
+    STATIC_REQUIRE(lookup.entries[1].key_ == 20u);
+    STATIC_REQUIRE(lookup.entries[2].key_ == 30u);
+    STATIC_REQUIRE(lookup.entries[3].key_ == 40u);
+}
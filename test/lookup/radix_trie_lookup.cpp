@@ -0,0 +1,128 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/radix_trie_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+
+namespace {
+using trie = lookup::radix_trie_lookup<>;
+
+constexpr auto splitmix64(std::uint64_t &state) -> std::uint64_t {
+    auto z = (state += 0x9e37'79b9'7f4a'7c15u);
+    z = (z ^ (z >> 30u)) * 0xbf58'476d'1ce4'e5b9u;
+    z = (z ^ (z >> 27u)) * 0x94d0'49bb'1331'11ebu;
+    return z ^ (z >> 31u);
+}
+
+template <std::size_t N> constexpr auto sparse_entries() {
+    auto entries = std::array<lookup::entry<std::uint64_t, std::uint32_t>, N>{};
+    auto state = std::uint64_t{N};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        entries[i] = {splitmix64(state), static_cast<std::uint32_t>(i + 1)};
+    }
+    return entries;
+}
+
+// each key has one bit set: no bit can be left out of a pseudo_pext mask
+constexpr auto one_hot_entries() {
+    auto entries = std::array<lookup::entry<std::uint64_t, int>, 64>{};
+    for (auto i = std::size_t{}; i < 64; ++i) {
+        entries[i] = {std::uint64_t{1} << i, static_cast<int>(i + 1)};
+    }
+    return entries;
+}
+} // namespace
+
+TEST_CASE("trie lookup of a few keys", "[radix trie]") {
+    constexpr auto lookup = trie::make(CX_VALUE(lookup::input{
+        -1, std::array{lookup::entry{10u, 1}, lookup::entry{200u, 2},
+                       lookup::entry{3000u, 3}, lookup::entry{40000u, 4}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    STATIC_REQUIRE(lookup[10u] == 1);
+    STATIC_REQUIRE(lookup[200u] == 2);
+    STATIC_REQUIRE(lookup[3000u] == 3);
+    STATIC_REQUIRE(lookup[40000u] == 4);
+    STATIC_REQUIRE(lookup[11u] == -1);
+    STATIC_REQUIRE(lookup[0u] == -1);
+    STATIC_REQUIRE(lookup[0xffff'ffffu] == -1);
+}
+
+TEST_CASE("trie of no keys or one key", "[radix trie]") {
+    constexpr auto empty =
+        trie::make(CX_VALUE(lookup::input<std::uint32_t, int, 0>{7}));
+    STATIC_REQUIRE(empty[0u] == 7);
+    STATIC_REQUIRE(empty[42u] == 7);
+
+    constexpr auto one = trie::make(
+        CX_VALUE(lookup::input{7, std::array{lookup::entry{42u, 1}}}));
+    STATIC_REQUIRE(one[42u] == 1);
+    STATIC_REQUIRE(one[43u] == 7);
+    STATIC_REQUIRE(one[42u + 64u] == 7);
+}
+
+TEST_CASE("trie of sparse 64-bit keys", "[radix trie]") {
+    constexpr static auto entries = sparse_entries<1000>();
+    constexpr auto lookup = trie::make(CX_VALUE(
+        lookup::input<std::uint64_t, std::uint32_t, 1000>{0, entries}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+
+    for (auto const &[k, v] : entries) {
+        CHECK(lookup[k] == v);
+    }
+    auto rng = std::mt19937_64{1};
+    for (auto i = std::size_t{}; i < 10'000; ++i) {
+        CHECK(lookup[rng()] == 0);
+        CHECK(lookup[entries[i % 1000].key_ ^ 1u] == 0);
+    }
+
+    // random keys are told apart within four levels, and the nodes take
+    // about a third as much space as the entries
+    constexpr auto c = lookup::cost(lookup);
+    CHECK(c.probes <= 5);
+    CHECK(sizeof(lookup.nodes) < sizeof(lookup.entries) / 3);
+}
+
+TEST_CASE("trie with composite keys", "[radix trie]") {
+    using pair_key_t = std::tuple<std::uint8_t, std::uint16_t>;
+    constexpr auto lookup = trie::make(CX_VALUE(lookup::input{
+        -1, std::array{lookup::entry{pair_key_t{1, 2}, 5},
+                       lookup::entry{pair_key_t{2, 1}, 6}}}));
+    STATIC_REQUIRE(lookup[pair_key_t{1, 2}] == 5);
+    STATIC_REQUIRE(lookup[pair_key_t{2, 1}] == 6);
+    STATIC_REQUIRE(lookup[pair_key_t{1, 1}] == -1);
+}
+
+TEST_CASE("trie fails when keys need too many levels", "[radix trie]") {
+    constexpr auto lookup =
+        lookup::radix_trie_lookup<2>::make(CX_VALUE(lookup::input{
+            0, std::array{lookup::entry{0x10'0000u, 1},
+                          lookup::entry{0x10'0001u, 2},
+                          lookup::entry{0u, 3}}}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("default strategy falls back to the trie", "[radix trie]") {
+    constexpr static auto entries = one_hot_entries();
+    constexpr auto pext = lookup::pseudo_pext_lookup<true, 2>::make(
+        CX_VALUE(lookup::input<std::uint64_t, int, 64>{0, entries}));
+    STATIC_REQUIRE(lookup::strategy_failed(pext));
+
+    constexpr auto lookup = lookup::make(
+        CX_VALUE(lookup::input<std::uint64_t, int, 64>{0, entries}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    for (auto const &[k, v] : entries) {
+        CHECK(lookup[k] == v);
+    }
+    CHECK(lookup[0u] == 0);
+    CHECK(lookup[3u] == 0);
+}
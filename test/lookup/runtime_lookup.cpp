@@ -0,0 +1,178 @@
+#include <lookup/arena.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/runtime_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace {
+constexpr auto routes = std::array{
+    lookup::entry{0x0a00'0001u, 1u}, lookup::entry{0x0a00'0002u, 2u},
+    lookup::entry{0x0a00'0101u, 3u}, lookup::entry{0x0a01'0001u, 4u},
+    lookup::entry{0xc0a8'0001u, 5u}, lookup::entry{0xc0a8'00ffu, 6u},
+    lookup::entry{0x7f00'0001u, 7u}, lookup::entry{0xffff'ffffu, 8u},
+};
+} // namespace
+
+TEST_CASE("runtime table finds every entry", "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<4096>{};
+    auto const table = lookup::build_runtime(0u, routes, arena);
+    REQUIRE(table.has_value());
+
+    for (auto const &[k, v] : routes) {
+        CHECK((*table)[k] == v);
+    }
+    CHECK((*table)[0u] == 0u);
+    CHECK((*table)[0x0a00'0003u] == 0u);
+    CHECK((*table)[0xffff'fffeu] == 0u);
+}
+
+TEST_CASE("runtime table has the compile-time layout", "[runtime lookup]") {
+    constexpr auto ct = lookup::pseudo_pext_lookup<true, 2>::make(
+        CX_VALUE(lookup::input{0u, routes}));
+
+    auto arena = lookup::fixed_arena<4096>{};
+    auto const rt = lookup::build_runtime<2>(0u, routes, arena);
+    REQUIRE(rt.has_value());
+
+    CHECK(rt->pext_func.mask == ct.pext_func.mask);
+    REQUIRE(rt->lookup_table.size() == ct.lookup_table.size());
+    for (auto i = std::size_t{}; i < ct.lookup_table.size(); ++i) {
+        CHECK(rt->lookup_table[i] == ct.lookup_table[i]);
+    }
+    for (auto i = std::size_t{}; i < ct.storage.size(); ++i) {
+        CHECK(rt->storage[i].key_ == ct.storage[i].key_);
+        CHECK(rt->storage[i].value_ == ct.storage[i].value_);
+    }
+}
+
+TEST_CASE("runtime table from a span of entries", "[runtime lookup]") {
+    auto rng = std::mt19937{7};
+    auto keys = std::uniform_int_distribution<std::uint16_t>{};
+    auto entries = std::vector<lookup::entry<std::uint16_t, int>>{};
+    while (entries.size() < 300) {
+        auto const k = keys(rng);
+        if (std::none_of(entries.begin(), entries.end(),
+                         [&](auto const &e) { return e.key_ == k; })) {
+            entries.push_back({k, static_cast<int>(entries.size()) + 1});
+        }
+    }
+
+    auto arena = lookup::fixed_arena<1u << 16u>{};
+    auto const table = lookup::build_runtime(
+        -1, std::span<lookup::entry<std::uint16_t, int> const>{entries},
+        arena);
+    REQUIRE(table.has_value());
+
+    auto found = std::size_t{};
+    for (auto k = 0u; k <= 0xffffu; ++k) {
+        auto const v = (*table)[static_cast<std::uint16_t>(k)];
+        if (v != -1) {
+            ++found;
+            CHECK(entries[static_cast<std::size_t>(v - 1)].key_ == k);
+        }
+    }
+    CHECK(found == entries.size());
+}
+
+TEST_CASE("runtime table of signed and composite keys", "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<4096>{};
+
+    constexpr auto signed_entries =
+        std::array{lookup::entry{-1, 'a'}, lookup::entry{-100, 'b'},
+                   lookup::entry{0, 'c'}, lookup::entry{42, 'd'}};
+    auto const s = lookup::build_runtime('x', signed_entries, arena);
+    REQUIRE(s.has_value());
+    CHECK((*s)[-1] == 'a');
+    CHECK((*s)[-100] == 'b');
+    CHECK((*s)[0] == 'c');
+    CHECK((*s)[42] == 'd');
+    CHECK((*s)[1] == 'x');
+
+    using tuple_key_t = std::tuple<std::uint8_t, std::uint16_t>;
+    constexpr auto composite_entries =
+        std::array{lookup::entry{tuple_key_t{1, 1}, 10},
+                   lookup::entry{tuple_key_t{1, 2}, 20},
+                   lookup::entry{tuple_key_t{2, 1}, 30}};
+    auto const c = lookup::build_runtime(0, composite_entries, arena);
+    REQUIRE(c.has_value());
+    CHECK((*c)[tuple_key_t{1, 1}] == 10);
+    CHECK((*c)[tuple_key_t{1, 2}] == 20);
+    CHECK((*c)[tuple_key_t{2, 1}] == 30);
+    CHECK((*c)[tuple_key_t{2, 2}] == 0);
+}
+
+TEST_CASE("empty runtime table returns the default", "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<256>{};
+    auto const table = lookup::build_runtime(
+        5, std::span<lookup::entry<std::uint32_t, int> const>{}, arena);
+    REQUIRE(table.has_value());
+    CHECK((*table)[0u] == 5);
+    CHECK((*table)[17u] == 5);
+}
+
+TEST_CASE("runtime build fails on duplicate keys", "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<4096>{};
+    constexpr auto entries =
+        std::array{lookup::entry{1u, 1}, lookup::entry{2u, 2},
+                   lookup::entry{1u, 3}};
+    CHECK(not lookup::build_runtime(0, entries, arena).has_value());
+}
+
+TEST_CASE("runtime build fails when the arena is exhausted",
+          "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<64>{};
+    CHECK(not lookup::build_runtime(0u, routes, arena).has_value());
+}
+
+TEST_CASE("runtime build fails when the keys need too wide a mask",
+          "[runtime lookup]") {
+    // one-hot keys differ in every bit, so a search length of 1 needs a mask
+    // of 63 bits
+    auto entries = std::array<lookup::entry<std::uint64_t, int>, 64>{};
+    for (auto i = std::size_t{}; i < entries.size(); ++i) {
+        entries[i] = {std::uint64_t{1} << i, static_cast<int>(i)};
+    }
+    auto arena = lookup::fixed_arena<16384>{};
+    CHECK(lookup::build_runtime<1>(0, entries, arena) == std::nullopt);
+    CHECK(arena.size() == 0);
+}
+
+TEST_CASE("scratch space is given back to the arena", "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<4096>{};
+    auto const table = lookup::build_runtime(0u, routes, arena);
+    REQUIRE(table.has_value());
+    CHECK(arena.size() <= table->lookup_table.size_bytes() +
+                              table->storage.size_bytes() +
+                              alignof(std::max_align_t));
+}
+
+TEST_CASE("a failed build gives back everything it allocated",
+          "[runtime lookup]") {
+    auto arena = lookup::fixed_arena<4096>{};
+    static_cast<void>(arena.allocate(3, 1));
+    auto const used = arena.size();
+
+    constexpr auto duplicates =
+        std::array{lookup::entry{1u, 1}, lookup::entry{2u, 2},
+                   lookup::entry{1u, 3}};
+    CHECK(not lookup::build_runtime(0, duplicates, arena).has_value());
+    CHECK(arena.size() == used);
+
+    auto small_arena = lookup::fixed_arena<64>{};
+    CHECK(not lookup::build_runtime(0u, routes, small_arena).has_value());
+    CHECK(small_arena.size() == 0);
+}
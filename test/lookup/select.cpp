@@ -0,0 +1,66 @@
+#include <lookup/detail/select.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+// not constexpr, so that the runtime selects are used
+template <typename T> auto opaque(T t) -> T {
+    auto volatile v = t;
+    return v;
+}
+
+enum struct signed_key : std::int16_t { neg = -5, zero = 0, pos = 5 };
+
+struct wide_value {
+    std::array<std::uint32_t, 5> words;
+    friend constexpr auto operator==(wide_value const &, wide_value const &)
+        -> bool = default;
+};
+} // namespace
+
+TEST_CASE("select equal keys", "[select]") {
+    using lookup::detail::select;
+    CHECK(select(opaque(3u), 3u, 10, 20) == 10);
+    CHECK(select(opaque(3u), 4u, 10, 20) == 20);
+    CHECK(select(opaque(std::uint8_t{0xff}), std::uint8_t{0xff}, 'a', 'b') ==
+          'a');
+    CHECK(select(opaque(-1), -1, 1.5, 2.5) == 1.5);
+    CHECK(select(opaque(-1), 1, 1.5, 2.5) == 2.5);
+    CHECK(select(opaque(signed_key::neg), signed_key::neg, 1, 2) == 1);
+    CHECK(select(opaque(std::uint64_t{1} << 40u), std::uint64_t{1}, 1, 2) ==
+          2);
+}
+
+TEST_CASE("select less than", "[select]") {
+    using lookup::detail::select_lt;
+    CHECK(select_lt(opaque(3u), 4u, 10, 20) == 10);
+    CHECK(select_lt(opaque(4u), 4u, 10, 20) == 20);
+    CHECK(select_lt(opaque(0xffff'ffffu), 4u, 10, 20) == 20);
+    CHECK(select_lt(opaque(-1), 4, 10, 20) == 10);
+    CHECK(select_lt(opaque(4), -1, 10, 20) == 20);
+    CHECK(select_lt(opaque(std::int8_t{-128}), std::int8_t{127}, 1, 2) == 1);
+    CHECK(select_lt(opaque(signed_key::neg), signed_key::zero, 1, 2) == 1);
+    CHECK(select_lt(opaque(signed_key::pos), signed_key::zero, 1, 2) == 2);
+}
+
+TEST_CASE("select wide values", "[select]") {
+    using lookup::detail::select;
+    using lookup::detail::select_lt;
+    constexpr auto a = wide_value{{1, 2, 3, 4, 5}};
+    constexpr auto b = wide_value{{6, 7, 8, 9, 10}};
+    CHECK(select(opaque(1), 1, a, b) == a);
+    CHECK(select(opaque(1), 2, a, b) == b);
+    CHECK(select_lt(opaque(1), 2, a, b) == a);
+    CHECK(select_lt(opaque(2), 1, a, b) == b);
+}
+
+TEST_CASE("select at compile time", "[select]") {
+    using lookup::detail::select;
+    using lookup::detail::select_lt;
+    STATIC_REQUIRE(select(1, 1, 10, 20) == 10);
+    STATIC_REQUIRE(select_lt(-1, 1, 10, 20) == 10);
+    STATIC_REQUIRE(select(signed_key::pos, signed_key::neg, 10, 20) == 20);
+}
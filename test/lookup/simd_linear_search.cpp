@@ -0,0 +1,111 @@
+#include <lookup/input.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+using SLS = lookup::simd_linear_search_lookup<64>;
+
+template <typename K, std::size_t N> constexpr auto make_input() {
+    std::array<lookup::entry<K, int>, N> entries{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        entries[i] = {static_cast<K>(i * 3 + 1), static_cast<int>(i + 100)};
+    }
+    return lookup::input<K, int, N>{-1, entries};
+}
+
+template <typename K, std::size_t N> auto check_all() -> void {
+    constexpr auto lookup = SLS::make(CX_VALUE(make_input<K, N>()));
+    for (auto i = std::size_t{}; i < N; ++i) {
+        CHECK(lookup[static_cast<K>(i * 3 + 1)] == static_cast<int>(i + 100));
+        CHECK(lookup[static_cast<K>(i * 3 + 2)] == -1);
+    }
+    CHECK(lookup[0] == -1);
+}
+} // namespace
+
+TEST_CASE("a lookup with more entries than allowed", "[simd linear search]") {
+    constexpr auto lookup = lookup::simd_linear_search_lookup<2>::make(
+        CX_VALUE(lookup::input<int, int, 3>{
+            0, std::array{lookup::entry{1, 1}, lookup::entry{2, 2},
+                          lookup::entry{3, 3}}}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("a lookup with no entries", "[simd linear search]") {
+    constexpr auto lookup = SLS::make(CX_VALUE(lookup::input<int>{42}));
+    CHECK(lookup[0] == 42);
+}
+
+TEST_CASE("a lookup with some entries", "[simd linear search]") {
+    constexpr auto lookup =
+        SLS::make(CX_VALUE(lookup::input<std::uint32_t, std::uint32_t, 2>{
+            11u, std::array{lookup::entry{1u, 17u}, lookup::entry{2u, 42u}}}));
+    CHECK(lookup[0u] == 11u);
+    CHECK(lookup[1u] == 17u);
+    CHECK(lookup[2u] == 42u);
+}
+
+TEST_CASE("a lookup that matches the padding key", "[simd linear search]") {
+    constexpr auto lookup =
+        SLS::make(CX_VALUE(lookup::input<std::uint8_t, int, 3>{
+            0, std::array{lookup::entry<std::uint8_t, int>{7, 1},
+                          lookup::entry<std::uint8_t, int>{8, 2},
+                          lookup::entry<std::uint8_t, int>{9, 3}}}));
+    CHECK(lookup[std::uint8_t{7}] == 1);
+    CHECK(lookup[std::uint8_t{8}] == 2);
+    CHECK(lookup[std::uint8_t{9}] == 3);
+    CHECK(lookup[std::uint8_t{0}] == 0);
+}
+
+TEST_CASE("lookups across key widths and sizes", "[simd linear search]") {
+    check_all<std::uint8_t, 64>();
+    check_all<std::uint16_t, 33>();
+    check_all<std::uint32_t, 17>();
+    check_all<std::uint32_t, 64>();
+    check_all<std::uint64_t, 5>();
+    check_all<std::uint64_t, 64>();
+}
+
+TEST_CASE("a lookup with 64-bit keys that differ in one half",
+          "[simd linear search]") {
+    using entry_t = lookup::entry<std::uint64_t, int>;
+    constexpr auto lookup =
+        SLS::make(CX_VALUE(lookup::input<std::uint64_t, int, 2>{
+            0, std::array{entry_t{0x1'0000'0002u, 1},
+                          entry_t{0x2'0000'0001u, 2}}}));
+    CHECK(lookup[0x1'0000'0002u] == 1);
+    CHECK(lookup[0x2'0000'0001u] == 2);
+    CHECK(lookup[0x1'0000'0001u] == 0);
+    CHECK(lookup[0x2'0000'0002u] == 0);
+}
+
+TEST_CASE("a lookup with non-integer values", "[simd linear search]") {
+    constexpr auto lookup =
+        SLS::make(CX_VALUE(lookup::input<std::uint32_t, float, 2>{
+            3.14f,
+            std::array{lookup::entry{1u, 17.0f}, lookup::entry{2u, 42.0f}}}));
+    CHECK(lookup[0u] == 3.14f);
+    CHECK(lookup[1u] == 17.0f);
+    CHECK(lookup[2u] == 42.0f);
+}
+
+TEST_CASE("a lookup used at compile time", "[simd linear search]") {
+    constexpr auto lookup = SLS::make(CX_VALUE(make_input<std::uint16_t, 9>()));
+    STATIC_REQUIRE(lookup[std::uint16_t{4}] == 101);
+    STATIC_REQUIRE(lookup[std::uint16_t{5}] == -1);
+}
+
+TEST_CASE("selectable as a strategy", "[simd linear search]") {
+    using S = lookup::strategies<lookup::simd_linear_search_lookup<2>, SLS>;
+    constexpr auto lookup = S::make(CX_VALUE(make_input<std::uint32_t, 4>()));
+    CHECK(lookup[7u] == 102);
+    CHECK(lookup[8u] == -1);
+}
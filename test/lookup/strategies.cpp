@@ -0,0 +1,126 @@
+#include <lookup/cost.hpp>
+#include <lookup/dense_array_lookup.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategies.hpp>
+#include <lookup/strategy_failed.hpp>
+
+#include <stdx/type_traits.hpp>
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+constexpr auto sparse_input = CX_VALUE(lookup::input<std::uint32_t, int, 6>{
+    -1, std::array{
+            lookup::entry{0x0000'0011u, 1}, lookup::entry{0x0000'2200u, 2},
+            lookup::entry{0x0033'0000u, 3}, lookup::entry{0x4400'0000u, 4},
+            lookup::entry{0x5000'0005u, 5}, lookup::entry{0x0600'0600u, 6}}});
+
+using direct_t = lookup::pseudo_pext_lookup<false, 1>;
+using indirect_t = lookup::pseudo_pext_lookup<true, 3>;
+
+template <typename T, typename U> constexpr auto same_table(T, U) -> bool {
+    return std::is_same_v<T, U>;
+}
+
+// a strategy that does not compile if it is ever built
+struct never_built {
+    template <typename Input>
+    [[nodiscard]] consteval static auto make(Input)
+        -> lookup::strategy_failed_t {
+        static_assert(stdx::always_false_v<Input>);
+        return {};
+    }
+};
+} // namespace
+
+TEST_CASE("tables report their cost", "[strategies]") {
+    constexpr auto direct = direct_t::make(sparse_input);
+    constexpr auto indirect = indirect_t::make(sparse_input);
+    constexpr auto linear =
+        lookup::linear_search_lookup<8>::make(sparse_input);
+
+    STATIC_REQUIRE(lookup::cost(direct).bytes == sizeof(direct));
+    STATIC_REQUIRE(lookup::cost(direct).probes == 1);
+    STATIC_REQUIRE(lookup::cost(indirect).probes > 1);
+    STATIC_REQUIRE(lookup::cost(indirect).bytes < lookup::cost(direct).bytes);
+    STATIC_REQUIRE(lookup::cost(linear).probes == 6);
+}
+
+TEST_CASE("tables without a cost are assumed to probe once", "[strategies]") {
+    struct table {
+        std::uint32_t data[4];
+    };
+    STATIC_REQUIRE(lookup::cost(table{}) ==
+                   lookup::cost_t{sizeof(table), 1, 1});
+}
+
+TEST_CASE("the default policy picks the first success", "[strategies]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::dense_array_lookup<>, direct_t,
+                           indirect_t>::make(sparse_input);
+    STATIC_REQUIRE(same_table(lookup, direct_t::make(sparse_input)));
+    CHECK(lookup[0x4400'0000u] == 4);
+    CHECK(lookup[0x4400'0001u] == -1);
+}
+
+TEST_CASE("strategies after the first success are not built",
+          "[strategies]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::first_success, direct_t,
+                           never_built>::make(sparse_input);
+    STATIC_REQUIRE(same_table(lookup, direct_t::make(sparse_input)));
+}
+
+TEST_CASE("nested strategies are tried in turn", "[strategies]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::first_success,
+                           lookup::strategies<lookup::dense_array_lookup<>,
+                                              lookup::linear_search_lookup<2>>,
+                           indirect_t, never_built>::make(sparse_input);
+    STATIC_REQUIRE(same_table(lookup, indirect_t::make(sparse_input)));
+}
+
+TEST_CASE("optimize_for_size picks the smallest table", "[strategies]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::optimize_for_size, direct_t,
+                           indirect_t>::make(sparse_input);
+    STATIC_REQUIRE(same_table(lookup, indirect_t::make(sparse_input)));
+    CHECK(lookup[0x0600'0600u] == 6);
+    CHECK(lookup[0x0600'0601u] == -1);
+}
+
+TEST_CASE("optimize_for_speed picks the fastest table", "[strategies]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::optimize_for_speed, indirect_t,
+                           direct_t>::make(sparse_input);
+    STATIC_REQUIRE(same_table(lookup, direct_t::make(sparse_input)));
+    CHECK(lookup[0x0033'0000u] == 3);
+}
+
+TEST_CASE("a weighted policy trades size for speed", "[strategies]") {
+    using size_heavy = lookup::weighted<1, 0, 0>;
+    using probe_heavy = lookup::weighted<0, 1, 0>;
+    STATIC_REQUIRE(same_table(
+        lookup::strategies<size_heavy, direct_t, indirect_t>::make(
+            sparse_input),
+        indirect_t::make(sparse_input)));
+    STATIC_REQUIRE(same_table(
+        lookup::strategies<probe_heavy, indirect_t, direct_t>::make(
+            sparse_input),
+        direct_t::make(sparse_input)));
+}
+
+TEST_CASE("failed strategies are never picked", "[strategies]") {
+    constexpr auto lookup =
+        lookup::strategies<lookup::optimize_for_size,
+                           lookup::dense_array_lookup<>,
+                           lookup::linear_search_lookup<2>>::make(sparse_input);
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
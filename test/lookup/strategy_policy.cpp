@@ -0,0 +1,31 @@
+#include <lookup/cost.hpp>
+#include <lookup/input.hpp>
+#include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/strategies.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+template <> inline auto lookup::strategy_policy<> = lookup::optimize_for_size{};
+
+TEST_CASE("the build-wide policy can be overridden", "[strategies]") {
+    using direct_t = lookup::pseudo_pext_lookup<false, 1>;
+    using indirect_t = lookup::pseudo_pext_lookup<true, 3>;
+
+    constexpr auto input = CX_VALUE(lookup::input<std::uint32_t, int, 4>{
+        -1, std::array{lookup::entry{0x0000'0011u, 1},
+                       lookup::entry{0x0000'2200u, 2},
+                       lookup::entry{0x0033'0000u, 3},
+                       lookup::entry{0x4400'0000u, 4}}});
+
+    constexpr auto lookup =
+        lookup::strategies<direct_t, indirect_t>::make(input);
+    STATIC_REQUIRE(std::is_same_v<std::remove_cv_t<decltype(lookup)>,
+                                  decltype(indirect_t::make(input))>);
+    CHECK(lookup[0x0033'0000u] == 3);
+}
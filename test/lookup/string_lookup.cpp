@@ -0,0 +1,95 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/string_lookup.hpp>
+
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <string_view>
+
+namespace {
+using namespace std::string_view_literals;
+using SL = lookup::string_lookup<lookup::default_strategy>;
+
+constexpr auto commands = std::array{
+    lookup::entry{"help"sv, 1},  lookup::entry{"halt"sv, 2},
+    lookup::entry{"reset"sv, 3}, lookup::entry{"read"sv, 4},
+    lookup::entry{"write"sv, 5}, lookup::entry{"writeback"sv, 6},
+    lookup::entry{""sv, 7},      lookup::entry{"r"sv, 8},
+};
+} // namespace
+
+TEST_CASE("string lookup finds every key", "[string lookup]") {
+    constexpr auto lookup = SL::make(CX_VALUE(lookup::input{0, commands}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    for (auto const &[k, v] : commands) {
+        CHECK(lookup[k] == v);
+    }
+}
+
+TEST_CASE("string lookup misses", "[string lookup]") {
+    constexpr auto lookup = SL::make(CX_VALUE(lookup::input{0, commands}));
+    STATIC_REQUIRE(lookup["hello"sv] == 0);
+    STATIC_REQUIRE(lookup["hulp"sv] == 0);
+    STATIC_REQUIRE(lookup["writebac"sv] == 0);
+    STATIC_REQUIRE(lookup["writebacks"sv] == 0);
+    STATIC_REQUIRE(lookup["x"sv] == 0);
+    STATIC_REQUIRE(lookup["resetx"sv] == 0);
+}
+
+TEST_CASE("string lookup uses few character positions", "[string lookup]") {
+    constexpr auto lookup = SL::make(CX_VALUE(lookup::input{0, commands}));
+    STATIC_REQUIRE(lookup.digest.positions.size() <= 2);
+}
+
+TEST_CASE("string lookup with ct_string entries", "[string lookup]") {
+    constexpr auto lookup = lookup::make(CX_VALUE(lookup::input{
+        -1, std::array{lookup::string_entry<"alpha">(1),
+                       lookup::string_entry<"beta">(2),
+                       lookup::string_entry<"gamma">(3)}}));
+    CHECK(lookup["alpha"sv] == 1);
+    CHECK(lookup["beta"sv] == 2);
+    CHECK(lookup["gamma"sv] == 3);
+    CHECK(lookup["delta"sv] == -1);
+}
+
+TEST_CASE("string lookup of many similar keys", "[string lookup]") {
+    constexpr auto lookup = lookup::make(CX_VALUE(lookup::input{
+        0, std::array{
+               lookup::entry{"config.net.ip"sv, 1},
+               lookup::entry{"config.net.mask"sv, 2},
+               lookup::entry{"config.net.gw"sv, 3},
+               lookup::entry{"config.dev.name"sv, 4},
+               lookup::entry{"config.dev.id"sv, 5},
+               lookup::entry{"config.log.level"sv, 6},
+               lookup::entry{"config.log.sink"sv, 7},
+               lookup::entry{"config.net.dns"sv, 8},
+           }}));
+    CHECK(lookup["config.net.ip"sv] == 1);
+    CHECK(lookup["config.net.mask"sv] == 2);
+    CHECK(lookup["config.net.gw"sv] == 3);
+    CHECK(lookup["config.dev.name"sv] == 4);
+    CHECK(lookup["config.dev.id"sv] == 5);
+    CHECK(lookup["config.log.level"sv] == 6);
+    CHECK(lookup["config.log.sink"sv] == 7);
+    CHECK(lookup["config.net.dns"sv] == 8);
+    CHECK(lookup["config.net.ipx"sv] == 0);
+    CHECK(lookup["config.dev.ip"sv] == 0);
+}
+
+TEST_CASE("keys that need too many positions fail", "[string lookup]") {
+    constexpr auto lookup = SL::make(CX_VALUE(lookup::input{
+        0, std::array{lookup::entry{"aaaaaaaaaa"sv, 1},
+                      lookup::entry{"baaaaaaaaa"sv, 2},
+                      lookup::entry{"abaaaaaaaa"sv, 3},
+                      lookup::entry{"aabaaaaaaa"sv, 4},
+                      lookup::entry{"aaabaaaaaa"sv, 5},
+                      lookup::entry{"aaaabaaaaa"sv, 6},
+                      lookup::entry{"aaaaabaaaa"sv, 7},
+                      lookup::entry{"aaaaaabaaa"sv, 8},
+                      lookup::entry{"aaaaaaabaa"sv, 9}}}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
@@ -0,0 +1,185 @@
+#include <lookup/arena.hpp>
+#include <lookup/entry.hpp>
+#include <lookup/runtime_lookup.hpp>
+#include <lookup/swappable.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr auto num_keys = std::uint32_t{64};
+
+using table_t = lookup::runtime_lookup<std::uint32_t, std::uint32_t, 2>;
+using arena_t = lookup::fixed_arena<8192>;
+
+// generation g maps key k to g * 1000 + k
+auto build(arena_t &arena, std::uint32_t generation) -> table_t {
+    auto entries =
+        std::array<lookup::entry<std::uint32_t, std::uint32_t>, num_keys>{};
+    for (auto k = std::uint32_t{}; k < num_keys; ++k) {
+        entries[k] = {k * 0x9e37'79b9u, generation * 1000 + k};
+    }
+    arena.rewind(0);
+    return *lookup::build_runtime(0u, entries, arena);
+}
+} // namespace
+
+TEST_CASE("lookups see the published table", "[swappable]") {
+    auto arenas = std::array<arena_t, 2>{};
+    auto s = lookup::swappable<table_t>{build(arenas[0], 1)};
+    CHECK(s[0] == 1000);
+    CHECK(s[5 * 0x9e37'79b9u] == 1005);
+    CHECK(s.version() == 0);
+
+    s.publish(build(arenas[1], 2));
+    CHECK(s[0] == 2000);
+    CHECK(s[5 * 0x9e37'79b9u] == 2005);
+    CHECK(s[1] == 0);
+    CHECK(s.version() == 1);
+}
+
+TEST_CASE("readers are registered up to the limit", "[swappable]") {
+    auto arena = arena_t{};
+    auto s = lookup::swappable<table_t, 2>{build(arena, 1)};
+    auto r1 = s.register_reader();
+    auto r2 = s.register_reader();
+    REQUIRE(r1.has_value());
+    REQUIRE(r2.has_value());
+    CHECK(not s.register_reader().has_value());
+
+    r1.reset();
+    CHECK(s.register_reader().has_value());
+}
+
+TEST_CASE("publish waits for registered readers", "[swappable]") {
+    auto arenas = std::array<arena_t, 2>{};
+    auto s = lookup::swappable<table_t>{build(arenas[0], 1)};
+    auto r = s.register_reader();
+    REQUIRE(r.has_value());
+
+    auto published = std::atomic<bool>{};
+    auto writer = std::thread{[&] {
+        s.publish(build(arenas[1], 2));
+        published = true;
+    }};
+
+    // the reader has not been quiescent since the swap began
+    while (s.version() == 0) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    CHECK(not published);
+
+    r->quiescent();
+    writer.join();
+    CHECK(published);
+}
+
+TEST_CASE("readers never see a table being rebuilt", "[swappable]") {
+    constexpr auto num_readers = 3;
+    constexpr auto num_generations = std::uint32_t{2000};
+
+    auto arenas = std::array<arena_t, 2>{};
+    auto s = lookup::swappable<table_t>{build(arenas[0], 0)};
+
+    auto done = std::atomic<bool>{};
+    auto errors = std::atomic<int>{};
+    auto lookups = std::atomic<std::size_t>{};
+
+    auto readers = std::vector<std::thread>{};
+    for (auto i = 0; i < num_readers; ++i) {
+        auto r = s.register_reader();
+        REQUIRE(r.has_value());
+        readers.emplace_back([&, r = std::move(*r)] {
+            auto last_generation = std::uint32_t{};
+            auto n = std::size_t{};
+            while (not done) {
+                auto const &t = s.snapshot();
+                auto const generation = t[0] / 1000;
+                if (generation < last_generation) {
+                    ++errors;
+                }
+                for (auto k = std::uint32_t{}; k < num_keys; ++k) {
+                    if (t[k * 0x9e37'79b9u] != generation * 1000 + k) {
+                        ++errors;
+                    }
+                }
+                last_generation = generation;
+                n += num_keys + 1;
+                r.quiescent();
+            }
+            lookups += n;
+        });
+    }
+
+    // the arena behind each replaced table is reused for the next but one
+    for (auto g = std::uint32_t{1}; g <= num_generations; ++g) {
+        s.publish(build(arenas[g % 2], g));
+    }
+    done = true;
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    CHECK(errors == 0);
+    CHECK(lookups > 0);
+    CHECK(s[0] == num_generations * 1000);
+}
+
+TEST_CASE("readers registered during a publish never see a replaced table",
+          "[swappable]") {
+    constexpr auto num_readers = 3;
+    constexpr auto num_generations = std::uint32_t{20000};
+
+    auto arenas = std::array<arena_t, 2>{};
+    auto s = lookup::swappable<table_t>{build(arenas[0], 0)};
+
+    auto done = std::atomic<bool>{};
+    auto errors = std::atomic<int>{};
+    auto registrations = std::atomic<std::size_t>{};
+
+    // each reader registers, looks every key up once and unregisters, so
+    // that registrations race with the scan of the reader slots in publish
+    auto readers = std::vector<std::thread>{};
+    for (auto i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&] {
+            auto n = std::size_t{};
+            while (not done) {
+                auto const r = s.register_reader();
+                if (not r.has_value()) {
+                    ++errors;
+                    continue;
+                }
+                auto const &t = s.snapshot();
+                auto const generation = t[0] / 1000;
+                for (auto k = std::uint32_t{}; k < num_keys; ++k) {
+                    if (t[k * 0x9e37'79b9u] != generation * 1000 + k) {
+                        ++errors;
+                    }
+                }
+                ++n;
+                std::this_thread::yield();
+            }
+            registrations += n;
+        });
+    }
+
+    for (auto g = std::uint32_t{1}; g <= num_generations; ++g) {
+        s.publish(build(arenas[g % 2], g));
+    }
+    done = true;
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    CHECK(errors == 0);
+    CHECK(registrations > 0);
+}
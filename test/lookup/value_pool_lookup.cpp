@@ -0,0 +1,76 @@
+#include <lookup/entry.hpp>
+#include <lookup/input.hpp>
+#include <lookup/linear_search_lookup.hpp>
+#include <lookup/lookup.hpp>
+#include <lookup/value_pool_lookup.hpp>
+
+#include <stdx/bitset.hpp>
+#include <stdx/utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+using bitset = stdx::bitset<256, std::uint32_t>;
+using VP = lookup::value_pool_lookup<lookup::default_strategy>;
+
+constexpr auto a = bitset{stdx::place_bits, 1};
+constexpr auto b = bitset{stdx::place_bits, 2, 200};
+} // namespace
+
+TEST_CASE("repeated wide values are pooled", "[value pool]") {
+    constexpr auto lookup = VP::make(CX_VALUE(lookup::input<int, bitset, 6>{
+        bitset{}, std::array{lookup::entry{1, a}, lookup::entry{2, b},
+                             lookup::entry{3, a}, lookup::entry{40, b},
+                             lookup::entry{50, a}, lookup::entry{60, b}}}));
+    STATIC_REQUIRE(not lookup::strategy_failed(lookup));
+    STATIC_REQUIRE(lookup.pool.size() == 3);
+    STATIC_REQUIRE(sizeof(lookup) < 6 * sizeof(bitset));
+
+    CHECK(lookup[1] == a);
+    CHECK(lookup[2] == b);
+    CHECK(lookup[3] == a);
+    CHECK(lookup[40] == b);
+    CHECK(lookup[50] == a);
+    CHECK(lookup[60] == b);
+    CHECK(lookup[0] == bitset{});
+    CHECK(lookup[4] == bitset{});
+}
+
+TEST_CASE("pooled lookup can be used at compile time", "[value pool]") {
+    constexpr auto lookup = VP::make(CX_VALUE(lookup::input<int, bitset, 3>{
+        b, std::array{lookup::entry{1, a}, lookup::entry{2, a},
+                      lookup::entry{3, a}}}));
+    STATIC_REQUIRE(lookup[1] == a);
+    STATIC_REQUIRE(lookup[3] == a);
+    STATIC_REQUIRE(lookup[4] == b);
+}
+
+TEST_CASE("the pool index is as narrow as possible", "[value pool]") {
+    constexpr auto lookup = lookup::value_pool_lookup<
+        lookup::linear_search_lookup<4>>::make(
+        CX_VALUE(lookup::input<int, bitset, 3>{
+            bitset{}, std::array{lookup::entry{1, a}, lookup::entry{2, a},
+                                 lookup::entry{3, a}}}));
+    STATIC_REQUIRE(
+        std::is_same_v<typename decltype(lookup.table)::value_type,
+                       std::uint8_t>);
+}
+
+TEST_CASE("pooling fails when it would not save space", "[value pool]") {
+    constexpr auto lookup = VP::make(CX_VALUE(lookup::input<int, int, 3>{
+        0, std::array{lookup::entry{1, 1}, lookup::entry{2, 2},
+                      lookup::entry{3, 3}}}));
+    STATIC_REQUIRE(lookup::strategy_failed(lookup));
+}
+
+TEST_CASE("pooled lookup reports an extra probe", "[value pool]") {
+    constexpr auto lookup = VP::make(CX_VALUE(lookup::input<int, bitset, 4>{
+        bitset{}, std::array{lookup::entry{1, a}, lookup::entry{2, a},
+                             lookup::entry{3, b}, lookup::entry{4, b}}}));
+    STATIC_REQUIRE(lookup::cost(lookup).probes ==
+                   lookup::cost(lookup.table).probes + 1);
+}
@@ -0,0 +1,338 @@
+#include <log_fmt/logger.hpp>
+#include <match/ops.hpp>
+#include <msg/callback.hpp>
+#include <msg/decision_tree_service.hpp>
+#include <msg/field.hpp>
+#include <msg/message.hpp>
+#include <nexus/config.hpp>
+#include <nexus/nexus.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace {
+using namespace msg;
+
+using test_id_field =
+    field<"test_id_field", std::uint32_t>::located<at{0_dw, 31_msb, 24_lsb}>;
+using test_opcode_field =
+    field<"test_opcode_field", std::uint32_t>::located<at{0_dw, 15_msb, 0_lsb}>;
+using test_field_2 =
+    field<"test_field_2", std::uint32_t>::located<at{1_dw, 23_msb, 16_lsb}>;
+
+using msg_defn =
+    message<"test_msg", test_id_field, test_opcode_field, test_field_2>;
+using test_msg_t = owning<msg_defn>;
+
+struct test_service : decision_tree_service<test_msg_t> {};
+
+bool callback_success;
+
+constexpr auto test_callback = msg::callback<"TestCallback", msg_defn>(
+    msg::in<test_id_field, 0x80>, [](auto) { callback_success = true; });
+
+struct test_project {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>, cib::extend<test_service>(test_callback));
+};
+
+std::string log_buffer{};
+} // namespace
+
+template <>
+inline auto logging::config<> =
+    logging::fmt::config{std::back_inserter(log_buffer)};
+
+TEST_CASE("build handler", "[decision_tree_builder]") {
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    CHECK(cib::service<test_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x80}));
+    CHECK(callback_success);
+
+    callback_success = false;
+    CHECK(not cib::service<test_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x81}));
+    CHECK(not callback_success);
+}
+
+TEST_CASE("match output failure", "[decision_tree_builder]") {
+    log_buffer.clear();
+    cib::nexus<test_project> test_nexus{};
+    test_nexus.init();
+
+    CHECK(not cib::service<test_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x81}));
+    CAPTURE(log_buffer);
+    CHECK(log_buffer.find(
+              "None of the registered callbacks (1) claimed this message") !=
+          std::string::npos);
+}
+
+namespace {
+constexpr auto test_callback_multi_field =
+    msg::callback<"test_callback_multi_field", msg_defn>(
+        msg::in<test_id_field, 0x80, 0x42> and
+            msg::equal_to<test_opcode_field, 1>,
+        [](auto) { callback_success = true; });
+
+bool callback_success_single_field;
+
+constexpr auto test_callback_single_field =
+    msg::callback<"test_callback_single_field", msg_defn>(
+        msg::equal_to<test_id_field, 0x50>,
+        [](auto) { callback_success_single_field = true; });
+
+struct test_project_multi_field {
+    constexpr static auto config =
+        cib::config(cib::exports<test_service>,
+                    cib::extend<test_service>(test_callback_multi_field,
+                                              test_callback_single_field));
+};
+} // namespace
+
+TEST_CASE("build handler multi fields", "[decision_tree_builder]") {
+    cib::nexus<test_project_multi_field> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    callback_success_single_field = false;
+    cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x42, "test_opcode_field"_field = 1});
+    CHECK(callback_success);
+    CHECK(not callback_success_single_field);
+
+    // the tree narrows to one candidate, whose matcher still has to match
+    callback_success = false;
+    callback_success_single_field = false;
+    CHECK(not cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x80, "test_opcode_field"_field = 2}));
+    CHECK(not callback_success);
+    CHECK(not callback_success_single_field);
+
+    callback_success = false;
+    callback_success_single_field = false;
+    cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x50, "test_opcode_field"_field = 1});
+    CHECK(not callback_success);
+    CHECK(callback_success_single_field);
+}
+
+namespace {
+constexpr auto test_callback_not_single_field =
+    msg::callback<"test_callback_not_single_field", msg_defn>(
+        not msg::in<test_id_field, 0x50>,
+        [](auto) { callback_success_single_field = true; });
+
+struct test_project_not_single_field {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>,
+        cib::extend<test_service>(test_callback_not_single_field,
+                                  test_callback_multi_field));
+};
+} // namespace
+
+TEST_CASE("build handler not single field", "[decision_tree_builder]") {
+    cib::nexus<test_project_not_single_field> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    callback_success_single_field = false;
+    cib::service<test_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x50});
+    CHECK(not callback_success);
+    CHECK(not callback_success_single_field);
+
+    callback_success = false;
+    callback_success_single_field = false;
+    cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x80, "test_opcode_field"_field = 1});
+    CHECK(callback_success);
+    CHECK(callback_success_single_field);
+}
+
+namespace {
+constexpr auto test_callback_disjunction =
+    msg::callback<"test_callback_disjunction", msg_defn>(
+        msg::equal_to<test_id_field, 0x80> or
+            msg::equal_to<test_opcode_field, 1>,
+        [](auto) { callback_success = true; });
+
+struct test_project_disjunction {
+    constexpr static auto config =
+        cib::config(cib::exports<test_service>,
+                    cib::extend<test_service>(test_callback_disjunction));
+};
+} // namespace
+
+TEST_CASE("build handler disjunction", "[decision_tree_builder]") {
+    cib::nexus<test_project_disjunction> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x80, "test_opcode_field"_field = 2});
+    CHECK(callback_success);
+
+    callback_success = false;
+    cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x81, "test_opcode_field"_field = 1});
+    CHECK(callback_success);
+
+    callback_success = false;
+    cib::service<test_service>->handle(test_msg_t{
+        "test_id_field"_field = 0x81, "test_opcode_field"_field = 2});
+    CHECK(not callback_success);
+}
+
+namespace {
+bool low_called;
+bool mid_called;
+bool exact_called;
+
+constexpr auto low_callback = msg::callback<"low", msg_defn>(
+    msg::less_than<test_opcode_field, 10>, [](auto) { low_called = true; });
+constexpr auto mid_callback = msg::callback<"mid", msg_defn>(
+    msg::greater_than_or_equal_to<test_opcode_field, 10> and
+        msg::less_than_or_equal_to<test_opcode_field, 20>,
+    [](auto) { mid_called = true; });
+constexpr auto exact_callback = msg::callback<"exact", msg_defn>(
+    msg::equal_to<test_opcode_field, 15> and msg::equal_to<test_field_2, 3>,
+    [](auto) { exact_called = true; });
+
+struct test_project_ranges {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>,
+        cib::extend<test_service>(low_callback, mid_callback, exact_callback));
+};
+} // namespace
+
+TEST_CASE("build handler field ranges", "[decision_tree_builder]") {
+    cib::nexus<test_project_ranges> test_nexus{};
+    test_nexus.init();
+
+    auto const check_opcode = [](std::uint32_t opcode, bool low, bool mid,
+                                 bool exact) {
+        low_called = mid_called = exact_called = false;
+        cib::service<test_service>->handle(test_msg_t{
+            "test_opcode_field"_field = opcode, "test_field_2"_field = 3});
+        CAPTURE(opcode);
+        CHECK(low_called == low);
+        CHECK(mid_called == mid);
+        CHECK(exact_called == exact);
+    };
+
+    check_opcode(0, true, false, false);
+    check_opcode(9, true, false, false);
+    check_opcode(10, false, true, false);
+    check_opcode(15, false, true, true);
+    check_opcode(20, false, true, false);
+    check_opcode(21, false, false, false);
+}
+
+namespace {
+int callback_count{};
+
+constexpr auto unconditional_callback =
+    msg::callback<"unconditional", msg_defn>([](auto) { ++callback_count; });
+
+struct test_project_unconditional {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>,
+        cib::extend<test_service>(test_callback, unconditional_callback));
+};
+} // namespace
+
+TEST_CASE("callback without field terms is always a candidate",
+          "[decision_tree_builder]") {
+    cib::nexus<test_project_unconditional> test_nexus{};
+    test_nexus.init();
+
+    callback_count = 0;
+    callback_success = false;
+    CHECK(cib::service<test_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x80}));
+    CHECK(callback_success);
+    CHECK(callback_count == 1);
+
+    callback_success = false;
+    CHECK(cib::service<test_service>->handle(
+        test_msg_t{"test_id_field"_field = 0x81}));
+    CHECK(not callback_success);
+    CHECK(callback_count == 2);
+}
+
+namespace {
+int callback_extra_arg{};
+
+constexpr auto test_callback_extra_args =
+    msg::callback<"test_callback_extra_args", msg_defn>(
+        msg::equal_to<test_id_field, 0x80>, [](auto, int i) {
+            callback_success = true;
+            callback_extra_arg = i;
+        });
+
+struct test_service_extra_args : decision_tree_service<test_msg_t, int> {};
+struct test_project_extra_args {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service_extra_args>,
+        cib::extend<test_service_extra_args>(test_callback_extra_args));
+};
+} // namespace
+
+TEST_CASE("handle extra arguments", "[decision_tree_builder]") {
+    cib::nexus<test_project_extra_args> test_nexus{};
+    test_nexus.init();
+
+    callback_success = false;
+    cib::service<test_service_extra_args>->handle(
+        test_msg_t{"test_id_field"_field = 0x80}, 42);
+    CHECK(callback_success);
+    CHECK(callback_extra_arg == 42);
+}
+
+namespace {
+using base_storage_t = msg_defn::default_storage_t;
+struct raw_service : decision_tree_service<base_storage_t> {};
+
+constexpr auto raw_view_callback = msg::callback<"raw view", msg_defn>(
+    msg::in<test_id_field, 0x80>,
+    [](msg::const_view<msg_defn>) { ++callback_count; });
+
+struct raw_view_project {
+    constexpr static auto config = cib::config(
+        cib::exports<raw_service>, cib::extend<raw_service>(raw_view_callback));
+};
+} // namespace
+
+TEST_CASE("handle raw message by view", "[decision_tree_builder]") {
+    cib::nexus<raw_view_project> test_nexus{};
+    test_nexus.init();
+
+    callback_count = 0;
+    CHECK(cib::service<raw_service>->handle(
+        std::array{0x8000ba11u, 0x0042d00du}));
+    CHECK(callback_count == 1);
+}
+
+TEST_CASE("handle a batch of messages", "[decision_tree_builder]") {
+    cib::nexus<test_project_multi_field> test_nexus{};
+    test_nexus.init();
+
+    auto const msgs = std::array{
+        test_msg_t{"test_id_field"_field = 0x42, "test_opcode_field"_field = 1},
+        test_msg_t{"test_id_field"_field = 0x81},
+        test_msg_t{"test_id_field"_field = 0x50}};
+
+    callback_success = false;
+    callback_success_single_field = false;
+    CHECK(cib::service<test_service>->handle_batch(msgs) == 2);
+    CHECK(callback_success);
+    CHECK(callback_success_single_field);
+}
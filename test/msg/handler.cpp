@@ -2,6 +2,7 @@
 #include <msg/callback.hpp>
 #include <msg/field.hpp>
 #include <msg/handler.hpp>
+#include <msg/handler_interface.hpp>
 #include <msg/message.hpp>
 
 #include <stdx/tuple.hpp>
@@ -11,6 +12,7 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
+#include <span>
 #include <string>
 
 namespace {
@@ -204,3 +206,47 @@ TEST_CASE("dispatch with extra args", "[handler]") {
     CHECK(handler.handle(msg, 0xcafe));
     CHECK(dispatched);
 }
+
+TEST_CASE("dispatch a batch of messages", "[handler]") {
+    int count{};
+
+    auto callback = msg::callback<"cb", msg_defn>(
+        id_match<0x80>, [&](msg::const_view<msg_defn>) { ++count; });
+    using msg_t = std::array<std::uint32_t, 2>;
+    auto const msgs = std::array{msg_t{0x8000ba11u, 0x0042d00du},
+                                 msg_t{0x4400ba11u, 0x0042d00du},
+                                 msg_t{0x8000ba11u, 0x0042d00du}};
+
+    auto callbacks = stdx::make_tuple(callback);
+    static auto handler =
+        msg::handler<void, decltype(callbacks), msg_t>{callbacks};
+
+    CHECK(handler.handle_batch(msgs) == 2);
+    CHECK(count == 2);
+}
+
+namespace {
+using raw_msg_t = std::array<std::uint32_t, 2>;
+
+// a handler written before handle_batch was part of the interface
+struct odd_id_handler : msg::handler_interface<raw_msg_t> {
+    auto is_match(raw_msg_t const &m) const -> bool override {
+        return (m[0] >> 24u) % 2 == 1;
+    }
+    auto handle(raw_msg_t const &m) const -> bool override {
+        return is_match(m);
+    }
+};
+} // namespace
+
+TEST_CASE("handle_batch defaults to handling each message in turn",
+          "[handler]") {
+    auto const msgs = std::array{raw_msg_t{0x8100ba11u, 0x0042d00du},
+                                 raw_msg_t{0x4400ba11u, 0x0042d00du},
+                                 raw_msg_t{0x8300ba11u, 0x0042d00du}};
+
+    auto const handler = odd_id_handler{};
+    msg::handler_interface<raw_msg_t> const &base = handler;
+    CHECK(base.handle_batch(msgs) == 2);
+    CHECK(base.handle_batch(std::span<raw_msg_t const>{}) == 0);
+}
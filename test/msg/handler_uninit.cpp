@@ -6,6 +6,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -52,3 +53,13 @@ TEST_CASE("invoke handle on service when uninitialized (raw msg type)",
     CHECK(panic_string ==
           "Attempting to handle msg (raw_msg_t) before service is initialized");
 }
+
+TEST_CASE("invoke handle_batch on service when uninitialized", "[handler]") {
+    panics = 0;
+    auto const msg = test_msg_t{};
+    auto const views = std::array{msg_view_t{msg}, msg_view_t{msg}};
+    cib::service<test_service>->handle_batch(views);
+    CHECK(panics == 1);
+    CHECK(panic_string ==
+          "Attempting to handle msg (msg) before service is initialized");
+}
@@ -9,9 +9,11 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <string>
+#include <utility>
 
 namespace {
 using namespace msg;
@@ -545,3 +547,74 @@ TEST_CASE("call template callback", "[indexed_builder]") {
         test_msg_t{"test_id_field"_field = 0x80});
     CHECK(callback_success);
 }
+
+namespace {
+int callback_count{};
+
+template <std::size_t I>
+constexpr auto counting_callback = msg::callback<"CountingCallback", msg_defn>(
+    msg::in<test_id_field, static_cast<std::uint32_t>(I % 4)>,
+    [](auto) { ++callback_count; });
+
+struct test_project_many_cbs {
+    constexpr static auto config =
+        []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return cib::config(
+                cib::exports<test_service>,
+                cib::extend<test_service>(counting_callback<Is>...));
+        }(std::make_index_sequence<300>{});
+};
+} // namespace
+
+TEST_CASE("build handler with more than 256 callbacks", "[indexed_builder]") {
+    cib::nexus<test_project_many_cbs> test_nexus{};
+    test_nexus.init();
+
+    callback_count = 0;
+    cib::service<test_service>->handle(test_msg_t{"test_id_field"_field = 1});
+    CHECK(callback_count == 75);
+}
+
+namespace {
+bool low_called;
+bool mid_called;
+bool exact_called;
+
+constexpr auto low_callback = msg::callback<"low", msg_defn>(
+    msg::less_than<test_opcode_field, 10>, [](auto) { low_called = true; });
+constexpr auto mid_callback = msg::callback<"mid", msg_defn>(
+    msg::greater_than_or_equal_to<test_opcode_field, 10> and
+        msg::less_than_or_equal_to<test_opcode_field, 20>,
+    [](auto) { mid_called = true; });
+constexpr auto exact_callback = msg::callback<"exact", msg_defn>(
+    msg::equal_to<test_opcode_field, 15>, [](auto) { exact_called = true; });
+
+struct test_project_ranges {
+    constexpr static auto config = cib::config(
+        cib::exports<test_service>,
+        cib::extend<test_service>(low_callback, mid_callback, exact_callback));
+};
+} // namespace
+
+TEST_CASE("build handler field ranges", "[indexed_builder]") {
+    cib::nexus<test_project_ranges> test_nexus{};
+    test_nexus.init();
+
+    auto const check_opcode = [](std::uint32_t opcode, bool low, bool mid,
+                                 bool exact) {
+        low_called = mid_called = exact_called = false;
+        cib::service<test_service>->handle(
+            test_msg_t{"test_opcode_field"_field = opcode});
+        CAPTURE(opcode);
+        CHECK(low_called == low);
+        CHECK(mid_called == mid);
+        CHECK(exact_called == exact);
+    };
+
+    check_opcode(0, true, false, false);
+    check_opcode(9, true, false, false);
+    check_opcode(10, false, true, false);
+    check_opcode(15, false, true, true);
+    check_opcode(20, false, true, false);
+    check_opcode(21, false, false, false);
+}
@@ -11,6 +11,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <type_traits>
 #include <unordered_map>
@@ -103,6 +104,28 @@ TEST_CASE("index not terms in a callback", "[indexed_callback]") {
     CHECK(intfield_index[0] == std::vector<std::size_t>{0, 0});
 }
 
+TEST_CASE("index relation terms in a callback", "[indexed_callback]") {
+    constexpr auto cb = msg::callback<"", msg_defn>(
+        msg::greater_than<int_f, 3> and
+            not msg::greater_than_or_equal_to<int_f, 9>,
+        [](auto) {});
+
+    auto terms = std::vector<std::pair<msg::rel_op, std::int32_t>>{};
+    msg::index_rel_terms(
+        cb.matcher,
+        [&]<typename T>(std::size_t, msg::rel_op op, auto value) {
+            if constexpr (std::is_same_v<T, int_f>) {
+                terms.emplace_back(op, value);
+            }
+        },
+        std::size_t{});
+    REQUIRE(terms.size() == 2);
+    CHECK(std::count(terms.begin(), terms.end(),
+                     std::pair{msg::rel_op::greater, 3}) == 1);
+    CHECK(std::count(terms.begin(), terms.end(),
+                     std::pair{msg::rel_op::less, 9}) == 1);
+}
+
 TEST_CASE("remove an indexed term from a callback", "[indexed_callback]") {
     constexpr auto cb = msg::callback<"", msg_defn>(
         msg::equal_to<int_f, 0> and msg::in<char_f, 'a', 'b'>, [](auto) {});
@@ -114,6 +137,16 @@ TEST_CASE("remove an indexed term from a callback", "[indexed_callback]") {
             match::or_t<equal_to_t<char_f, 'a'>, equal_to_t<char_f, 'b'>>>);
 }
 
+TEST_CASE("remove an indexed range term from a callback",
+          "[indexed_callback]") {
+    constexpr auto cb = msg::callback<"", msg_defn>(
+        msg::less_than<int_f, 5> and msg::equal_to<char_f, 'a'>, [](auto) {});
+
+    constexpr auto sut = msg::remove_match_terms<int_f>(cb);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(sut.matcher), equal_to_t<char_f, 'a'>>);
+}
+
 TEST_CASE("remove multiple indexed terms from a callback",
           "[indexed_callback]") {
     constexpr auto cb = msg::callback<"", msg_defn>(
@@ -36,6 +36,18 @@ using callback_t = auto (*)(test_msg const &) -> bool;
 template <auto N> using bitset = stdx::bitset<N, std::uint32_t>;
 
 bitset<32> callbacks_called{};
+
+int lookups{};
+
+template <bool Hit> struct counting_lookup {
+    using key_type = std::uint32_t;
+    using value_type = bitset<32>;
+
+    auto operator[](key_type) const -> value_type {
+        ++lookups;
+        return Hit ? value_type{stdx::place_bits, 0} : value_type{};
+    }
+};
 } // namespace
 
 TEST_CASE("create empty handler", "[indexed_handler]") {
@@ -208,3 +220,70 @@ TEST_CASE("separate handler input from callback parameter type",
     CHECK(h.handle(msg_match));
     CHECK(callbacks_called[0]);
 }
+
+TEST_CASE("handle a batch of messages", "[indexed_handler]") {
+    using lookup::entry;
+
+    constexpr auto h = msg::make_indexed_handler<test_msg>(
+        msg::indices{
+            msg::index{
+                opcode_field{},
+                lookup::make(
+                    CX_VALUE(lookup::input<std::uint32_t, bitset<32>, 2>{
+                        bitset<32>{},
+                        std::array{
+                            entry{0u, bitset<32>{stdx::place_bits, 0, 1}},
+                            entry{1u, bitset<32>{stdx::place_bits, 2}}}}))},
+            msg::index{
+                sub_opcode_field{},
+                lookup::make(
+                    CX_VALUE(lookup::input<std::uint32_t, bitset<32>, 2>{
+                        bitset<32>{stdx::place_bits, 2},
+                        std::array{
+                            entry{0u, bitset<32>{stdx::place_bits, 0, 2}},
+                            entry{1u, bitset<32>{stdx::place_bits, 1, 2}},
+                        }}))}},
+        std::array<callback_t, 3>{[](test_msg const &) {
+                                      callbacks_called.set(0);
+                                      return true;
+                                  },
+                                  [](test_msg const &) {
+                                      callbacks_called.set(1);
+                                      return true;
+                                  },
+                                  [](test_msg const &) {
+                                      callbacks_called.set(2);
+                                      return true;
+                                  }});
+
+    // more messages than are looked up at once
+    auto msgs = std::array<test_msg, 70>{};
+    auto expected = std::size_t{};
+    for (auto i = 0u; i < msgs.size(); ++i) {
+        msgs[i] = test_msg{"opcode_field"_field = i % 3,
+                           "sub_opcode_field"_field = (i / 3) % 3};
+        expected += h.is_match(msgs[i]) ? 1u : 0u;
+    }
+
+    callbacks_called.reset();
+    CHECK(h.handle_batch(msgs) == expected);
+    CHECK(callbacks_called == bitset<32>{stdx::place_bits, 0, 1, 2});
+    CHECK(h.handle_batch({}) == 0);
+}
+
+TEST_CASE("indices stop looking up once there are no candidates",
+          "[indexed_handler]") {
+    constexpr auto miss =
+        msg::indices{msg::index{opcode_field{}, counting_lookup<false>{}},
+                     msg::index{sub_opcode_field{}, counting_lookup<true>{}}};
+    lookups = 0;
+    CHECK(miss(test_msg{}).none());
+    CHECK(lookups == 1);
+
+    constexpr auto hit =
+        msg::indices{msg::index{opcode_field{}, counting_lookup<true>{}},
+                     msg::index{sub_opcode_field{}, counting_lookup<true>{}}};
+    lookups = 0;
+    CHECK(hit(test_msg{})[0]);
+    CHECK(lookups == 2);
+}
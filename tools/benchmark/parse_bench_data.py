@@ -2,6 +2,7 @@
 
 import argparse
 import csv
+import json
 import re
 
 
@@ -89,27 +90,112 @@ def generate_csv_tables(data, output_prefix):
             writer.writerow(row)
 
 
+def parse_records(file_path):
+    records = []
+    with open(file_path, "r") as file:
+        for line in file:
+            line = line.strip()
+            if line.startswith("{"):
+                try:
+                    records.append(json.loads(line))
+                except json.JSONDecodeError:
+                    continue
+    return records
+
+
+def record_key(record):
+    return (
+        record["dataset"],
+        record["algorithm"],
+        record.get("stream"),
+        record.get("miss_percent"),
+    )
+
+
+def merge_records(existing, new, compile_times):
+    merged = {record_key(r): r for r in existing}
+    for r in new:
+        merged[record_key(r)] = {**merged.get(record_key(r), {}), **r}
+
+    seconds = {
+        (c["dataset"], c["algorithm"]): c["compile_seconds"] for c in compile_times
+    }
+    for r in merged.values():
+        key = (r["dataset"], r["algorithm"])
+        if key in seconds:
+            r["compile_seconds"] = seconds[key]
+
+    return sorted(merged.values(), key=lambda r: tuple(str(k) for k in record_key(r)))
+
+
+def load_json_files(file_paths):
+    records = []
+    for file_path in file_paths:
+        with open(file_path, "r") as file:
+            text = file.read().strip()
+            if text.startswith("["):
+                records.extend(json.loads(text))
+            else:
+                records.extend(json.loads(line) for line in text.splitlines() if line)
+    return records
+
+
 def parse_cmdline():
     parser = argparse.ArgumentParser()
     parser.add_argument(
         "--input",
         type=str,
+        nargs="+",
         required=True,
-        help=("Path to the input results."),
+        help=("Paths to the input results."),
     )
     parser.add_argument(
         "--output_prefix",
         type=str,
-        required=True,
         help="Output filename prefix for the generated CSV file.",
     )
+    parser.add_argument(
+        "--json",
+        type=str,
+        help="Output filename for the merged JSON records.",
+    )
+    parser.add_argument(
+        "--merge",
+        type=str,
+        nargs="*",
+        default=[],
+        help="JSON record files from earlier runs to merge with the input.",
+    )
+    parser.add_argument(
+        "--compile_times",
+        type=str,
+        nargs="*",
+        default=[],
+        help="Compile time records (*.compile.json) written by time_compile.py.",
+    )
     return parser.parse_args()
 
 
 def main():
     args = parse_cmdline()
-    data = parse_file(args.input)
-    generate_csv_tables(data, args.output_prefix)
+
+    if args.output_prefix:
+        data = {}
+        for file_path in args.input:
+            for dataset, algorithms in parse_file(file_path).items():
+                data.setdefault(dataset, {}).update(algorithms)
+        generate_csv_tables(data, args.output_prefix)
+
+    if args.json:
+        records = [r for file_path in args.input for r in parse_records(file_path)]
+        merged = merge_records(
+            load_json_files(args.merge),
+            records,
+            load_json_files(args.compile_times),
+        )
+        with open(args.json, "w") as file:
+            json.dump(merged, file, indent=2)
+            file.write("\n")
 
 
 if __name__ == "__main__":
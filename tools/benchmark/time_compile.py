@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import subprocess
+import sys
+import time
+
+
+def parse_cmdline():
+    parser = argparse.ArgumentParser(
+        description="Run a compile command and record how long it took."
+    )
+    parser.add_argument(
+        "--output",
+        type=str,
+        required=True,
+        help="Output filename for the JSON compile time record.",
+    )
+    parser.add_argument("--dataset", type=str, required=True)
+    parser.add_argument("--algorithm", type=str, required=True)
+    parser.add_argument("command", nargs=argparse.REMAINDER)
+    return parser.parse_args()
+
+
+def main():
+    args = parse_cmdline()
+    command = args.command[1:] if args.command[:1] == ["--"] else args.command
+
+    start = time.monotonic()
+    result = subprocess.run(command)
+    elapsed = time.monotonic() - start
+
+    if result.returncode == 0:
+        with open(args.output, "w") as f:
+            json.dump(
+                {
+                    "dataset": args.dataset,
+                    "algorithm": args.algorithm,
+                    "compile_seconds": round(elapsed, 3),
+                },
+                f,
+            )
+            f.write("\n")
+
+    sys.exit(result.returncode)
+
+
+if __name__ == "__main__":
+    main()
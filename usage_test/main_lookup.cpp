@@ -1,11 +1,34 @@
+#include <lookup/arena.hpp>
+#include <lookup/batch.hpp>
+#include <lookup/cost.hpp>
+#include <lookup/dense_array_lookup.hpp>
+#include <lookup/detail/batch.hpp>
+#include <lookup/detail/key.hpp>
+#include <lookup/detail/pext.hpp>
 #include <lookup/detail/select.hpp>
+#include <lookup/detail/simd.hpp>
 #include <lookup/entry.hpp>
+#include <lookup/hw_pext_lookup.hpp>
+#include <lookup/info.hpp>
 #include <lookup/input.hpp>
+#include <lookup/interval.hpp>
+#include <lookup/interval_lookup.hpp>
 #include <lookup/linear_search_lookup.hpp>
 #include <lookup/lookup.hpp>
+#include <lookup/multiword_pext_lookup.hpp>
+#include <lookup/perfect_hash_lookup.hpp>
+#include <lookup/prefilter_lookup.hpp>
+#include <lookup/profiled_lookup.hpp>
 #include <lookup/pseudo_pext_lookup.hpp>
+#include <lookup/radix_trie_lookup.hpp>
+#include <lookup/runtime_lookup.hpp>
+#include <lookup/simd_linear_search_lookup.hpp>
 #include <lookup/strategies.hpp>
 #include <lookup/strategy_failed.hpp>
+#include <lookup/string_lookup.hpp>
+#include <lookup/swappable.hpp>
+#include <lookup/two_level_lookup.hpp>
+#include <lookup/value_pool_lookup.hpp>
 
 #if __STDC_HOSTED__ == 0
 extern "C" auto main() -> int;